@@ -2,67 +2,55 @@
  * Problem: 1023 - Drought
  * Platform: BeeCrowd
  * Language: C++17 (Optimized)
- * Logic: Bucket Sort + Raw Buffer I/O
+ * Logic: Bucket Sort + Raw Buffer I/O (common/fastio.hpp)
  */
 
-#include <cstdio>
 #include <cstring>
 #include <vector>
+#include "../common/fastio.hpp"
+#include "../common/engine.hpp"
 
 using namespace std;
 
-// CONSTANTS
-// 8MB Buffer to safely read huge inputs in one go
-const int BUF_SIZE = 1024 * 1024 * 8;
-char buffer[BUF_SIZE];
-int buf_idx = 0;
-int bytes_read = 0;
-
-/**
- * Fast Integer Reader
- * Reads characters directly from the buffer and constructs the integer.
- * Much faster than scanf because it skips format parsing.
- */
-inline int readInt()
+// Input is mmap()ed (or read in 1 MB blocks) and output is buffered,
+// see common/fastio.hpp. The state lives in the engine (common/engine.hpp).
+struct DroughtEngine : ReentrantEngine<DroughtEngine>
 {
-  int sum = 0;
-  // Skip non-digit characters (newlines, spaces)
-  while (buffer[buf_idx] < '0' || buffer[buf_idx] > '9')
+  // Frequency array (Buckets)
+  // Indices 0-200 represent the average consumption.
+  int counts[205];
+
+  /**
+   * Fast Integer Reader
+   * Skips to the next token and parses its digits.
+   * Much faster than scanf because it skips format parsing.
+   * Returns 0 at the end of the input.
+   */
+  static inline int readInt(BlockReader &reader)
   {
-    buf_idx++;
-    if (buf_idx >= bytes_read)
+    int value = 0;
+    if (!reader.readInt(value))
       return 0;
+    return value;
   }
-  // Parse valid digits
-  while (buffer[buf_idx] >= '0' && buffer[buf_idx] <= '9')
-  {
-    sum = sum * 10 + (buffer[buf_idx] - '0');
-    buf_idx++;
-  }
-  return sum;
-}
 
-// Frequency array (Buckets)
-// Indices 0-200 represent the average consumption.
-int counts[205];
+  void run(BlockReader &reader, BufferedWriter &writer);
+};
 
-int main()
+void DroughtEngine::run(BlockReader &reader, BufferedWriter &writer)
 {
-  // Read standard input (File Descriptor 0) into memory
-  bytes_read = fread(buffer, 1, BUF_SIZE, stdin);
-
   int N;
   int cityNumber = 1;
   bool first = true;
 
   while (true)
   {
-    N = readInt();
+    N = readInt(reader);
     if (N == 0)
       break;
 
     if (!first)
-      printf("\n\n");
+      writer.write("\n\n");
     first = false;
 
     // Reset buckets for the new test case.
@@ -74,8 +62,8 @@ int main()
 
     for (int i = 0; i < N; ++i)
     {
-      int X = readInt(); // Residents
-      int Y = readInt(); // Consumption
+      int X = readInt(reader); // Residents
+      int Y = readInt(reader); // Consumption
 
       totalResid += X;
       totalCons += Y;
@@ -86,7 +74,9 @@ int main()
       counts[Y / X] += X;
     }
 
-    printf("Cidade# %d:\n", cityNumber++);
+    writer.write("Cidade# ");
+    writer.writeInt(cityNumber++);
+    writer.write(":\n");
 
     // Print Buckets
     // Since we iterate i from 0 to 200, the output is sorted by definition.
@@ -96,8 +86,10 @@ int main()
       if (counts[i] > 0)
       {
         if (!firstItem)
-          printf(" ");
-        printf("%d-%d", counts[i], i);
+          writer.put(' ');
+        writer.writeInt(counts[i]);
+        writer.put('-');
+        writer.writeInt(i);
         firstItem = false;
       }
     }
@@ -109,9 +101,27 @@ int main()
     int whole = avgInt / 100;
     int frac = avgInt % 100;
 
-    printf("\nConsumo medio: %d.%02d m3.", whole, frac);
+    writer.write("\nConsumo medio: ");
+    writer.writeInt(whole);
+    writer.put('.');
+    writer.put(char('0' + frac / 10));
+    writer.put(char('0' + frac % 10));
+    writer.write(" m3.");
   }
 
-  printf("\n");
+  writer.put('\n');
+}
+
+#ifndef P1023_NO_MAIN
+
+int main()
+{
+  BlockReader reader(BlockReader::ASYNC);
+  BufferedWriter writer;
+  DroughtEngine engine;
+  engine.run(reader, writer);
+  writer.flush();
   return 0;
 }
+
+#endif
@@ -3,38 +3,65 @@
  * Author: [Your Name/Handle]
  * Algorithm: Hybrid Greedy + Unbounded Knapsack
  * Complexity: O(C * N) where C is constant (~10,000)
+ *
+ * Build with -DTCA_STATS for per-case statistics on stderr
+ * (common/stats.hpp): blocks placed by the greedy step, DP cells filled
+ * and the width of the DP table.
  */
 
-#include <iostream>
 #include <vector>
 #include <algorithm>
 #include <climits>
+#include "../common/fastio.hpp"
+#include "../common/stats.hpp"
+#include "../common/engine.hpp"
 
 using namespace std;
 
+// DP statistics (common/stats.hpp), empty unless built with -DTCA_STATS
+enum
+{
+  C_GREEDY_BLOCKS,
+  C_DP_CELLS
+};
+enum
+{
+  H_DP_WIDTH
+};
+
 const int INF = 1e9;
 
-void solve()
+// Reentrant engine (common/engine.hpp)
+struct IceStatuesEngine : ReentrantEngine<IceStatuesEngine>
 {
-  int T;
-  // Fast I/O is crucial for competitive C++
-  if (!(cin >> T))
-    return;
+  Stats stats{{"greedy_blocks", "dp_cells"}, {"dp_width"}};
 
-  // We reuse this buffer to avoid memory allocation overhead per test case.
+  // We reuse this buffer to avoid memory allocation overhead per test case
+  // (and per input: the engine keeps it between runs).
   // Max needed size is approx 100 * 100 = 10,000.
   // 20,000 is a safe upper bound.
-  vector<int> dp(20000);
+  vector<int> dp = vector<int>(20000);
+
+  void run(BlockReader &reader, BufferedWriter &writer);
+};
+
+void IceStatuesEngine::run(BlockReader &reader, BufferedWriter &writer)
+{
+  int T;
+  // Fast I/O is crucial for competitive C++ (common/fastio.hpp)
+  if (!reader.readInt(T))
+    return;
 
   while (T--)
   {
-    int N, M;
-    cin >> N >> M;
+    int N = 0, M = 0;
+    reader.readInt(N);
+    reader.readInt(M);
 
     vector<int> coins(N);
     for (int i = 0; i < N; ++i)
     {
-      cin >> coins[i];
+      reader.readInt(coins[i]);
     }
 
     // 1. Sort Descending
@@ -64,12 +91,17 @@ void solve()
       {
         count += num_max_coins;
         M -= num_max_coins * max_coin;
+        stats.add(C_GREEDY_BLOCKS, num_max_coins);
       }
     }
 
     // 4. Dynamic Programming
     // Solve the small remainder using standard Unbounded Knapsack
 
+    // The loop below visits M x N cells
+    stats.add(C_DP_CELLS, (long long)M * N);
+    stats.sample(H_DP_WIDTH, M);
+
     // Reset DP table (only up to the new M)
     fill(dp.begin(), dp.begin() + M + 1, INF);
     dp[0] = 0;
@@ -89,14 +121,22 @@ void solve()
     }
 
     count += dp[M];
-    cout << count << "\n";
+    writer.writeInt(count);
+    writer.put('\n');
+    stats.endCase();
   }
 }
 
+#ifndef P1034_NO_MAIN
+
 int main()
 {
-  ios_base::sync_with_stdio(false);
-  cin.tie(NULL);
-  solve();
+  BlockReader reader;
+  BufferedWriter writer;
+  IceStatuesEngine engine;
+  engine.run(reader, writer);
+  writer.flush();
   return 0;
 }
+
+#endif
@@ -1,12 +1,12 @@
-#include <iostream>
 #include <vector>
-#include <string>
+#include <string_view>
 #include <queue>
 #include <cmath>
 #include <map>
-#include <iomanip>
 #include <limits>
 #include <algorithm>
+#include "../common/fastio.hpp"
+#include "../common/engine.hpp"
 
 using namespace std;
 
@@ -14,30 +14,46 @@ using namespace std;
 const int NUM_NODES = 25;
 // An edge is a pair<neighbor_id, distance>
 using Edge = pair<int, double>;
-// Adjacency list
-vector<vector<Edge>> adj(NUM_NODES);
-vector<int> deg(NUM_NODES, 0);
-double total_length = 0;
 
-// All-pairs shortest paths for odd nodes
-double odd_matrix[NUM_NODES][NUM_NODES];
-vector<int> odd_nodes;
+// Reentrant engine (common/engine.hpp): the graph of the current drawing
+struct DrawingEngine : ReentrantEngine<DrawingEngine>
+{
+  // Adjacency list
+  vector<vector<Edge>> adj = vector<vector<Edge>>(NUM_NODES);
+  vector<int> deg = vector<int>(NUM_NODES, 0);
+  double total_length = 0;
+
+  // All-pairs shortest paths for odd nodes
+  double odd_matrix[NUM_NODES][NUM_NODES];
+  vector<int> odd_nodes;
+
+  void link_point(int u, int v, double dist);
+  void link_segment(int u, int v, double dist);
+  void shortest_path(int start_node, vector<double> &dist);
+  int dfs_connected(int u, vector<bool> &visited);
+  void replace_link(int u, int target, int replacement, double new_dist);
+  void delete_loop_link(int u, int target);
+  void remove_path_points();
+  double find_min_matching(int mask, double current_sum, double longest_seg);
+  void solve_case(BlockReader &reader, BufferedWriter &writer, int case_num);
+  void run(BlockReader &reader, BufferedWriter &writer);
+};
 
 // --- Helper Functions ---
 
 // Maps "A1" -> 0, "A2" -> 1, ..., "E5" -> 24
-inline int a1_to_id(const string &s)
+inline int a1_to_id(string_view s)
 {
   return (s[0] - 'A') * 5 + (s[1] - '1');
 }
 
-void link_point(int u, int v, double dist)
+void DrawingEngine::link_point(int u, int v, double dist)
 {
   adj[u].emplace_back(v, dist);
   deg[u]++;
 }
 
-void link_segment(int u, int v, double dist)
+void DrawingEngine::link_segment(int u, int v, double dist)
 {
   link_point(u, v, dist);
   link_point(v, u, dist);
@@ -46,7 +62,7 @@ void link_segment(int u, int v, double dist)
 
 // --- Graph Algorithms ---
 
-void shortest_path(int start_node, vector<double> &dist)
+void DrawingEngine::shortest_path(int start_node, vector<double> &dist)
 {
   fill(dist.begin(), dist.end(), numeric_limits<double>::infinity());
   dist[start_node] = 0;
@@ -75,7 +91,7 @@ void shortest_path(int start_node, vector<double> &dist)
   }
 }
 
-int dfs_connected(int u, vector<bool> &visited)
+int DrawingEngine::dfs_connected(int u, vector<bool> &visited)
 {
   visited[u] = true;
   int count = 1;
@@ -91,7 +107,7 @@ int dfs_connected(int u, vector<bool> &visited)
 }
 
 // Replaces link 'target' with 'replacement' in u's adj list
-void replace_link(int u, int target, int replacement, double new_dist)
+void DrawingEngine::replace_link(int u, int target, int replacement, double new_dist)
 {
   for (auto &edge : adj[u])
   {
@@ -105,7 +121,7 @@ void replace_link(int u, int target, int replacement, double new_dist)
 }
 
 // Deletes links to 'target' from u's adj list
-void delete_loop_link(int u, int target)
+void DrawingEngine::delete_loop_link(int u, int target)
 {
   auto it = adj[u].begin();
   while (it != adj[u].end())
@@ -122,7 +138,7 @@ void delete_loop_link(int u, int target)
   }
 }
 
-void remove_path_points()
+void DrawingEngine::remove_path_points()
 {
   for (int u = 0; u < NUM_NODES; ++u)
   {
@@ -151,7 +167,7 @@ void remove_path_points()
 
 // --- Core Matching Logic ---
 
-double find_min_matching(int mask, double current_sum, double longest_seg)
+double DrawingEngine::find_min_matching(int mask, double current_sum, double longest_seg)
 {
   if (mask == 0)
   {
@@ -192,12 +208,20 @@ double find_min_matching(int mask, double current_sum, double longest_seg)
 
 // --- Main Solve Function ---
 
-void solve_case(int case_num)
+// "Case <k>: "
+void writeCase(BufferedWriter &writer, int case_num)
+{
+  writer.write("Case ");
+  writer.writeInt(case_num);
+  writer.write(": ");
+}
+
+void DrawingEngine::solve_case(BlockReader &reader, BufferedWriter &writer, int case_num)
 {
-  int n;
-  cin >> n;
+  int n = 0;
+  reader.readInt(n);
 
-  // Reset global state
+  // Reset the engine's state
   for (int i = 0; i < NUM_NODES; ++i)
   {
     adj[i].clear();
@@ -208,7 +232,8 @@ void solve_case(int case_num)
 
   if (n == 0)
   {
-    cout << "Case " << case_num << ": 0.00\n";
+    writeCase(writer, case_num);
+    writer.write("0.00\n");
     return;
   }
 
@@ -217,10 +242,13 @@ void solve_case(int case_num)
 
   for (int i = 0; i < n; ++i)
   {
-    string s1, s2;
-    cin >> s1 >> s2;
-    int id1 = a1_to_id(s1);
-    int id2 = a1_to_id(s2);
+    // Each token points into the input buffer until the next read:
+    // decode the first one before reading the second.
+    string_view s;
+    reader.readWord(s);
+    int id1 = a1_to_id(s);
+    reader.readWord(s);
+    int id2 = a1_to_id(s);
 
     if (start_node == -1)
       start_node = id1;
@@ -268,7 +296,8 @@ void solve_case(int case_num)
   vector<bool> visited(NUM_NODES, false);
   if (num_graph_nodes > 0 && dfs_connected(start_node, visited) != num_graph_nodes)
   {
-    cout << "Case " << case_num << ": ~x(\n";
+    writeCase(writer, case_num);
+    writer.write("~x(\n");
     return;
   }
 
@@ -285,11 +314,12 @@ void solve_case(int case_num)
   }
 
   int num_odd = odd_nodes.size();
-  cout << "Case " << case_num << ": " << fixed << setprecision(2);
+  writeCase(writer, case_num);
 
   if (num_odd == 0 || num_odd == 2)
   {
-    cout << total_length << "\n";
+    writer.writeFixed(total_length, 2);
+    writer.put('\n');
   }
   else
   {
@@ -309,21 +339,31 @@ void solve_case(int case_num)
     // Initial mask with all odd nodes set
     int initial_mask = (1 << num_odd) - 1;
     double min_sum = find_min_matching(initial_mask, 0.0, 0.0);
-    cout << total_length + min_sum << "\n";
+    writer.writeFixed(total_length + min_sum, 2);
+    writer.put('\n');
   }
 }
 
-int main()
+void DrawingEngine::run(BlockReader &reader, BufferedWriter &writer)
 {
-  // Fast I/O
-  ios_base::sync_with_stdio(false);
-  cin.tie(NULL);
-
-  int t;
-  cin >> t;
+  int t = 0;
+  reader.readInt(t);
   for (int i = 1; i <= t; ++i)
   {
-    solve_case(i);
+    solve_case(reader, writer, i);
   }
+}
+
+#ifndef P1053_NO_MAIN
+
+int main()
+{
+  BlockReader reader;
+  BufferedWriter writer;
+  DrawingEngine engine;
+  engine.run(reader, writer);
+  writer.flush();
   return 0;
 }
+
+#endif
@@ -10,19 +10,39 @@
  * 4. Mutate the *local copy* 'points' to its canonical form.
  * 5. Run base cases and recursion on the mutated 'points'.
  * 6. Call 'saveAllRotations(key, ...)' to store the result.
+ *
+ * Build with -DTCA_STATS for per-case search statistics on stderr
+ * (common/stats.hpp): calls, memo hits / misses, memo size, recursion
+ * depth and sub-problem sizes.
  */
 
-#include <iostream>
 #include <vector>
-#include <string>
+#include <string_view>
 #include <numeric>   // For std::accumulate
 #include <algorithm> // For std::find, std::rotate
 #include <unordered_map>
 #include <iterator> // For std::distance
+#include "../common/fastio.hpp"
+#include "../common/stats.hpp"
+#include "../common/engine.hpp"
 
 using namespace std;
 typedef long long ll;
 
+// Search statistics (common/stats.hpp), empty unless built with -DTCA_STATS
+enum
+{
+  C_CALLS,
+  C_MEMO_HITS,
+  C_MEMO_MISSES,
+  C_MEMO_ENTRIES
+};
+enum
+{
+  H_DEPTH,
+  H_POINTS
+};
+
 // --- Pre-calculated Base Cases ---
 ll triArr[] = {
     1, 1, 3, 12, 55, 273, 1428, 7752, 43263,
@@ -42,8 +62,19 @@ struct VectorCharHasher
   }
 };
 
-// --- Memoization Cache ---
-unordered_map<vector<char>, ll, VectorCharHasher> memo;
+// --- Reentrant engine (common/engine.hpp) ---
+// Fast I/O (common/fastio.hpp) is passed to run()
+struct AttackingZonesEngine : ReentrantEngine<AttackingZonesEngine>
+{
+  Stats stats{{"calls", "memo_hits", "memo_misses", "memo_entries"}, {"depth", "points"}};
+
+  // --- Memoization Cache ---
+  unordered_map<vector<char>, ll, VectorCharHasher> memo;
+
+  void saveAllRotations(vector<char> key_vec, int num_points, ll result);
+  ll countZones(vector<char> points, int numPoints, int redsCount);
+  void run(BlockReader &reader, BufferedWriter &writer);
+};
 
 // --- Helper Functions ---
 
@@ -74,7 +105,7 @@ bool isAllRedsInMod3(const vector<char> &points)
 /**
  * @brief Pre-caches the answer for all N rotations.
  */
-void saveAllRotations(vector<char> key_vec, int num_points, ll result)
+void AttackingZonesEngine::saveAllRotations(vector<char> key_vec, int num_points, ll result)
 {
   memo[key_vec] = result;
   for (int i = 1; i < num_points; ++i)
@@ -91,8 +122,10 @@ void saveAllRotations(vector<char> key_vec, int num_points, ll result)
  * @param numPoints The size of the sub-problem.
  * @param redsCount The pre-computed red count.
  */
-ll solve(vector<char> points, int numPoints, int redsCount)
+ll AttackingZonesEngine::countZones(vector<char> points, int numPoints, int redsCount)
 {
+  auto scope = stats.enter(H_DEPTH);
+  stats.add(C_CALLS);
   if (numPoints == 0)
   {
     return 1;
@@ -106,8 +139,11 @@ ll solve(vector<char> points, int numPoints, int redsCount)
   auto it_memo = memo.find(original_key);
   if (it_memo != memo.end())
   {
+    stats.add(C_MEMO_HITS);
     return it_memo->second;
   }
+  stats.add(C_MEMO_MISSES);
+  stats.sample(H_POINTS, numPoints);
 
   int numTriag = numPoints / 3;
 
@@ -158,7 +194,7 @@ ll solve(vector<char> points, int numPoints, int redsCount)
     if (r1 > n1 / 3)
       continue;
 
-    ll area1 = solve(pointsA1, n1, r1);
+    ll area1 = countZones(pointsA1, n1, r1);
     if (area1 == 0)
       continue;
 
@@ -181,11 +217,11 @@ ll solve(vector<char> points, int numPoints, int redsCount)
       if (r3 > n3 / 3)
         continue;
 
-      ll area2 = solve(pointsA2, n2, r2);
+      ll area2 = countZones(pointsA2, n2, r2);
       if (area2 == 0)
         continue;
 
-      ll area3 = solve(pointsA3, n3, r3);
+      ll area3 = countZones(pointsA3, n3, r3);
 
       numTriagCount += area1 * area2 * area3;
     }
@@ -197,20 +233,17 @@ ll solve(vector<char> points, int numPoints, int redsCount)
   return numTriagCount;
 }
 
-// --- Main Function ---
-int main()
+// --- Driver ---
+void AttackingZonesEngine::run(BlockReader &reader, BufferedWriter &writer)
 {
-  ios_base::sync_with_stdio(false);
-  cin.tie(NULL);
-
-  int numCases;
-  cin >> numCases;
+  int numCases = 0;
+  reader.readInt(numCases);
   for (int i = 1; i <= numCases; ++i)
   {
-    int numPoints;
-    cin >> numPoints;
-    string line;
-    cin >> line;
+    int numPoints = 0;
+    reader.readInt(numPoints);
+    string_view line;
+    reader.readWord(line);
 
     vector<char> points(numPoints);
     int redsCount = 0;
@@ -229,9 +262,28 @@ int main()
 
     memo.clear();
 
-    // Pass 'points' by value. 'solve' gets its own copy.
-    cout << "Case " << i << ": " << solve(points, numPoints, redsCount) << "\n";
+    // Pass 'points' by value. 'countZones' gets its own copy.
+    ll result = countZones(points, numPoints, redsCount);
+    stats.add(C_MEMO_ENTRIES, memo.size());
+    stats.endCase();
+    writer.write("Case ");
+    writer.writeInt(i);
+    writer.write(": ");
+    writer.writeInt(result);
+    writer.put('\n');
   }
+}
+
+#ifndef P1058_NO_MAIN
 
+int main()
+{
+  BlockReader reader;
+  BufferedWriter writer;
+  AttackingZonesEngine engine;
+  engine.run(reader, writer);
+  writer.flush();
   return 0;
-}
\ No newline at end of file
+}
+
+#endif
\ No newline at end of file
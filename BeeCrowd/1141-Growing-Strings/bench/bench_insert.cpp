@@ -0,0 +1,148 @@
+/**
+ * Benchmark: trie insertion, one word at a time (insertWord) against the
+ * interleaved lanes of insertBatch.
+ *
+ * Usage: bench_insert <input.in | random> [reps]
+ *   input.in  a 1141 input (e.g. build/inputs/1141-wide.in): every dictionary
+ *   random    one dictionary of random words over a-z, 10^6 characters
+ * Prints one line per mode: words, characters, trie nodes, best insert time
+ * of 'reps' runs and characters/second. Only the insertion is timed; the
+ * answers of both modes are compared afterwards.
+ */
+
+#define P1141_NO_MAIN
+#include "../solution.cpp"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+struct Dictionary
+{
+  string words;
+  vector<int> wordStart;
+};
+
+vector<Dictionary> loadInput(const string &path)
+{
+  vector<Dictionary> dicts;
+  if (path == "random")
+  {
+    // Deterministic (fixed seed): 3-30 letters, up to the 10^6 limit
+    Dictionary d;
+    d.wordStart.push_back(0);
+    unsigned long long x = 88172645463325252ULL;
+    auto rnd = [&]
+    {
+      x ^= x << 13;
+      x ^= x >> 7;
+      x ^= x << 17;
+      return x;
+    };
+    while (d.words.size() < 1000000 - 30)
+    {
+      int len = 3 + rnd() % 28;
+      for (int i = 0; i < len; i++)
+        d.words.push_back(char('a' + rnd() % ALPHABET));
+      d.wordStart.push_back((int)d.words.size());
+    }
+    dicts.push_back(move(d));
+    return dicts;
+  }
+
+  ifstream in(path, ios::binary);
+  stringstream ss;
+  ss << in.rdbuf();
+  string text = ss.str();
+  BlockReader reader(text);
+  int n;
+  while (reader.readInt(n) && n != 0)
+  {
+    Dictionary d;
+    d.wordStart.push_back(0);
+    string_view s;
+    for (int i = 0; i < n && reader.readWord(s); i++)
+    {
+      d.words.append(s);
+      d.wordStart.push_back((int)d.words.size());
+    }
+    dicts.push_back(move(d));
+  }
+  return dicts;
+}
+
+// Inserts every dictionary in a fresh trie; returns the insert seconds
+// ('build': the seconds of buildAutomaton on the trie built)
+double insertAll(GrowingStringsEngine &engine, vector<Dictionary> &dicts, bool batch,
+                 long long &nodes, long long &answers, double &build)
+{
+  double seconds = 0;
+  build = 0;
+  nodes = answers = 0;
+  for (Dictionary &d : dicts)
+  {
+    engine.nodesCount = 1;
+    engine.clearNode(0);
+    auto t0 = chrono::steady_clock::now();
+    if (batch)
+    {
+      engine.words.swap(d.words);
+      engine.wordStart.swap(d.wordStart);
+      engine.insertBatch();
+      engine.words.swap(d.words);
+      engine.wordStart.swap(d.wordStart);
+    }
+    else
+    {
+      for (size_t i = 0; i + 1 < d.wordStart.size(); i++)
+        engine.insertWord(string_view(d.words.data() + d.wordStart[i], d.wordStart[i + 1] - d.wordStart[i]));
+    }
+    seconds += chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    nodes += engine.nodesCount;
+    auto t1 = chrono::steady_clock::now();
+    answers = answers * 1000003 + engine.buildAutomaton();
+    build += chrono::duration<double>(chrono::steady_clock::now() - t1).count();
+  }
+  return seconds;
+}
+
+int main(int argc, char **argv)
+{
+  if (argc < 2)
+  {
+    fprintf(stderr, "usage: bench_insert <input.in | random> [reps]\n");
+    return 2;
+  }
+  int reps = argc > 2 ? atoi(argv[2]) : 5;
+  vector<Dictionary> dicts = loadInput(argv[1]);
+  long long words = 0, chars = 0;
+  for (const Dictionary &d : dicts)
+  {
+    words += (long long)d.wordStart.size() - 1;
+    chars += (long long)d.words.size();
+  }
+
+  static GrowingStringsEngine engine; // Static: the tables are large
+  long long answers[2] = {0, 0};
+  for (int batch = 0; batch < 2; batch++)
+  {
+    double best = 1e30, bestBuild = 1e30, build;
+    long long nodes = 0;
+    for (int r = 0; r < reps; r++)
+    {
+      best = min(best, insertAll(engine, dicts, batch, nodes, answers[batch], build));
+      bestBuild = min(bestBuild, build);
+    }
+    printf("%-6s lanes=%d words=%lld chars=%lld nodes=%lld insert=%.1f ms %.1f Mchars/s build=%.1f ms\n",
+           batch ? "batch" : "single", batch ? LANES : 1, words, chars, nodes,
+           best * 1e3, chars / best / 1e6, bestBuild * 1e3);
+  }
+  if (answers[0] != answers[1])
+  {
+    fprintf(stderr, "answers differ between the two modes\n");
+    return 1;
+  }
+  return 0;
+}
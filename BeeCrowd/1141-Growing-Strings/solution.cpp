@@ -1,8 +1,12 @@
-#include <iostream>
 #include <vector>
 #include <queue>
 #include <cstring>
 #include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include "../common/fastio.hpp"
+#include "../common/engine.hpp"
 
 using namespace std;
 
@@ -10,16 +14,54 @@ using namespace std;
 const int MAX_NODES = 1000005; // 10^6 + 5
 const int ALPHABET = 26;
 
-// Global Automaton Structures
-// We use static arrays for performance (better cache locality, no allocation overhead)
-int trieNodes[MAX_NODES][ALPHABET];
-int failLink[MAX_NODES];
-int dp[MAX_NODES]; // Previously nSubWords
-bool isWord[MAX_NODES];
-int nodesCount = 1;
+// Words inserted side by side by insertBatch()
+const int LANES = 8;
+
+// MAX_NODES elements from calloc(). Like the static arrays they replace,
+// the zero pages only become memory once touched, so an engine costs what
+// its largest dictionary used.
+template <class T>
+struct ZeroArray
+{
+  T *data = static_cast<T *>(calloc(MAX_NODES, sizeof(T)));
+
+  ZeroArray() = default;
+  ZeroArray(const ZeroArray &) = delete;
+  ZeroArray &operator=(const ZeroArray &) = delete;
+  ~ZeroArray() { free(data); }
+
+  T &operator[](int i) { return data[i]; }
+};
+
+// Reentrant engine (common/engine.hpp). Fast I/O (common/fastio.hpp):
+// words are read as views into the input, and a dictionary is gathered
+// in 'words' before it is inserted in one batch.
+struct GrowingStringsEngine : ReentrantEngine<GrowingStringsEngine>
+{
+  // Automaton Structures
+  // Flat arrays for performance (better cache locality, no allocation
+  // overhead): the engine keeps them for the next input.
+  ZeroArray<int[ALPHABET]> trieNodes;
+  ZeroArray<int> failLink;
+  ZeroArray<int> dp; // Previously nSubWords
+  ZeroArray<bool> isWord;
+  int nodesCount = 1;
+
+  // The dictionary being read: its words back to back, and where each
+  // one starts (a view of the reader does not outlive the next read)
+  string words;
+  vector<int> wordStart;
+
+  void clearNode(int node);
+  int child(int node, int idx);
+  void insertWord(string_view s);
+  void insertBatch();
+  int buildAutomaton();
+  void run(BlockReader &reader, BufferedWriter &writer);
+};
 
 // Reset only the row we are about to use (Lazy Clearing)
-void clearNode(int node)
+void GrowingStringsEngine::clearNode(int node)
 {
   memset(trieNodes[node], 0, sizeof(int) * ALPHABET);
   isWord[node] = false;
@@ -27,24 +69,96 @@ void clearNode(int node)
   failLink[node] = 0;
 }
 
-void insertWord(const string &s)
+// Child 'idx' of 'node', created if missing
+inline int GrowingStringsEngine::child(int node, int idx)
+{
+  if (!trieNodes[node][idx])
+  {
+    trieNodes[node][idx] = nodesCount;
+    clearNode(nodesCount); // Clear memory only when allocating
+    nodesCount++;
+  }
+  return trieNodes[node][idx];
+}
+
+void GrowingStringsEngine::insertWord(string_view s)
 {
   int curr = 0; // Root is 0
   for (char c : s)
+    curr = child(curr, c - 'a');
+  isWord[curr] = true;
+}
+
+// Inserts the gathered words, LANES at a time. One word's walk is a chain
+// of dependent loads into trieNodes (104 MB, mostly cache misses), so the
+// lanes take turns, one character each, and each lane prefetches the row
+// entry it reads next: LANES misses are in flight instead of one.
+// The trie is the one insertWord() builds, only numbered in another order.
+void GrowingStringsEngine::insertBatch()
+{
+  const char *pos[LANES], *end[LANES];
+  int curr[LANES];
+  int count = (int)wordStart.size() - 1, nextWord = 0, active = 0;
+
+  // Gives lane l the next non-empty word; false when none is left
+  auto load = [&](int l)
   {
-    int idx = c - 'a';
-    if (!trieNodes[curr][idx])
+    while (nextWord < count)
     {
-      trieNodes[curr][idx] = nodesCount;
-      clearNode(nodesCount); // Clear memory only when allocating
-      nodesCount++;
+      pos[l] = words.data() + wordStart[nextWord];
+      end[l] = words.data() + wordStart[nextWord + 1];
+      nextWord++;
+      if (pos[l] < end[l])
+      {
+        curr[l] = 0;
+        __builtin_prefetch(&trieNodes[0][*pos[l] - 'a']);
+        return true;
+      }
+      isWord[0] = true;
+    }
+    return false;
+  };
+
+  while (active < LANES && load(active))
+    active++;
+
+  while (active)
+  {
+    for (int l = 0; l < active;)
+    {
+      int node = trieNodes[curr[l]][*pos[l]++ - 'a'];
+      if (!node)
+      {
+        // The rest of the word is new: one run of consecutive nodes, as
+        // insertWord() numbers it (buildAutomaton() reads them in that order)
+        node = child(curr[l], pos[l][-1] - 'a');
+        while (pos[l] < end[l])
+          node = child(node, *pos[l]++ - 'a');
+      }
+      curr[l] = node;
+      if (pos[l] == end[l])
+      {
+        isWord[curr[l]] = true;
+        if (!load(l))
+        {
+          // No word left: the last lane takes this one's place
+          active--;
+          pos[l] = pos[active];
+          end[l] = end[active];
+          curr[l] = curr[active];
+          continue;
+        }
+      }
+      else
+      {
+        __builtin_prefetch(&trieNodes[curr[l]][*pos[l] - 'a']);
+      }
+      l++;
     }
-    curr = trieNodes[curr][idx];
   }
-  isWord[curr] = true;
 }
 
-int buildAutomaton()
+int GrowingStringsEngine::buildAutomaton()
 {
   queue<int> q;
   int maxChain = 0;
@@ -110,27 +224,40 @@ int buildAutomaton()
   return maxChain;
 }
 
-int main()
+void GrowingStringsEngine::run(BlockReader &reader, BufferedWriter &writer)
 {
-  // Fast I/O
-  ios::sync_with_stdio(false);
-  cin.tie(nullptr);
-
   int n;
-  while (cin >> n && n != 0)
+  while (reader.readInt(n) && n != 0)
   {
     // Reset for new test case
     nodesCount = 1;
     clearNode(0); // Clear root manually
 
-    string s;
-    for (int i = 0; i < n; i++)
+    words.clear();
+    wordStart.assign(1, 0);
+    string_view s;
+    for (int i = 0; i < n && reader.readWord(s); i++)
     {
-      cin >> s;
-      insertWord(s);
+      words.append(s);
+      wordStart.push_back((int)words.size());
     }
+    insertBatch();
 
-    cout << buildAutomaton() << "\n";
+    writer.writeInt(buildAutomaton());
+    writer.put('\n');
   }
+}
+
+#ifndef P1141_NO_MAIN
+
+int main()
+{
+  BlockReader reader;
+  BufferedWriter writer;
+  GrowingStringsEngine engine;
+  engine.run(reader, writer);
+  writer.flush();
   return 0;
 }
+
+#endif
@@ -2,15 +2,35 @@
  * Problem: 1231 - Words
  * Language: C++17 (Optimized)
  * Approach: Static Trie Arrays + DFS with 2D Visited Array
+ *
+ * Build with -DTCA_STATS for per-case search statistics on stderr
+ * (common/stats.hpp): trie sizes, states visited, revisits, restarts and
+ * the DFS depth.
  */
 
-#include <iostream>
 #include <vector>
-#include <string>
+#include <string_view>
 #include <cstring>
+#include <memory>
+#include "../common/fastio.hpp"
+#include "../common/stats.hpp"
+#include "../common/engine.hpp"
 
 using namespace std;
 
+// Search statistics (common/stats.hpp), empty unless built with -DTCA_STATS
+enum
+{
+    C_TRIE_NODES,
+    C_STATES,
+    C_REVISITS,
+    C_RESTARTS
+};
+enum
+{
+    H_DEPTH
+};
+
 // Structure to represent a Trie Node
 struct Node
 {
@@ -25,18 +45,28 @@ struct Node
     }
 };
 
-// We use two vectors to act as our memory pools for the two Tries.
-// This avoids the overhead of 'new' and pointer chasing.
-vector<Node> trie1;
-vector<Node> trie2;
+// Reentrant engine (common/engine.hpp)
+struct WordsEngine : ReentrantEngine<WordsEngine>
+{
+    Stats stats{{"trie_nodes", "states", "revisits", "restarts"}, {"depth"}};
+
+    // We use two vectors to act as our memory pools for the two Tries.
+    // This avoids the overhead of 'new' and pointer chasing.
+    vector<Node> trie1;
+    vector<Node> trie2;
 
-// Visited array for Memoization.
-// Max nodes calculation: 20 words * 40 chars = 800 nodes max.
-// We use 1000 to be safe.
-bool visited[1000][1000];
+    // Visited array for Memoization.
+    // Max nodes calculation: 20 words * 40 chars = 800 nodes max.
+    // We use 1000 to be safe. On the heap: 1 MB is too large for an
+    // engine on the stack.
+    unique_ptr<bool[][1000]> visited{new bool[1000][1000]};
+
+    bool dfs(int u, int v);
+    void run(BlockReader &reader, BufferedWriter &writer);
+};
 
 // Helper to insert words into our vector-based Trie
-void insert(vector<Node> &trie, const string &s)
+void insert(vector<Node> &trie, string_view s)
 {
     int curr = 0; // Start at root (index 0)
     for (char c : s)
@@ -57,12 +87,18 @@ void insert(vector<Node> &trie, const string &s)
 // DFS Function
 // u: current index in trie1
 // v: current index in trie2
-bool dfs(int u, int v)
+bool WordsEngine::dfs(int u, int v)
 {
+    auto scope = stats.enter(H_DEPTH);
+
     // 1. Check for Cycle / Already Visited State
     if (visited[u][v])
+    {
+        stats.add(C_REVISITS);
         return false;
+    }
     visited[u][v] = true;
+    stats.add(C_STATES);
 
     // 2. Check for Successful Match
     // If both nodes mark the end of a word, we have found a valid common sequence.
@@ -88,6 +124,7 @@ bool dfs(int u, int v)
     // while keeping 'v' at the same place.
     if (trie1[u].isEnd)
     {
+        stats.add(C_RESTARTS);
         if (dfs(0, v))
             return true;
     }
@@ -95,6 +132,7 @@ bool dfs(int u, int v)
     // If trie2 ends a word here, jump 'v' back to root (0).
     if (trie2[v].isEnd)
     {
+        stats.add(C_RESTARTS);
         if (dfs(u, 0))
             return true;
     }
@@ -102,14 +140,10 @@ bool dfs(int u, int v)
     return false;
 }
 
-int main()
+void WordsEngine::run(BlockReader &reader, BufferedWriter &writer)
 {
-    // Fast I/O
-    ios_base::sync_with_stdio(false);
-    cin.tie(NULL);
-
     int n1, n2;
-    while (cin >> n1 >> n2)
+    while (reader.readInt(n1) && reader.readInt(n2))
     {
         // Clear previous test case data
         trie1.clear();
@@ -119,15 +153,15 @@ int main()
         trie1.push_back(Node());
         trie2.push_back(Node());
 
-        string s;
+        string_view s;
         for (int i = 0; i < n1; i++)
         {
-            cin >> s;
+            reader.readWord(s);
             insert(trie1, s);
         }
         for (int i = 0; i < n2; i++)
         {
-            cin >> s;
+            reader.readWord(s);
             insert(trie2, s);
         }
 
@@ -140,15 +174,29 @@ int main()
             memset(visited[i], 0, trie2.size() * sizeof(bool));
         }
 
+        stats.add(C_TRIE_NODES, trie1.size() + trie2.size());
         if (dfs(0, 0))
         {
-            cout << "S" << "\n";
+            writer.write("S\n");
         }
         else
         {
-            cout << "N" << "\n";
+            writer.write("N\n");
         }
+        stats.endCase();
     }
+}
 
+#ifndef P1231_NO_MAIN
+
+int main()
+{
+    BlockReader reader;
+    BufferedWriter writer;
+    WordsEngine engine;
+    engine.run(reader, writer);
+    writer.flush();
     return 0;
 }
+
+#endif
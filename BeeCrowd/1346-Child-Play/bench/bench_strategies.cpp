@@ -0,0 +1,125 @@
+/**
+ * Benchmark: the search strategies of ChildPlayEngine (DFS, BITSET, MITM,
+ * SS) against the cost model (auto) on generated input classes.
+ *
+ * Usage: bench_strategies <class> [auto|dfs|bitset|mitm|ss | --print]
+ *   small       2000 sets of 1-10 cards, faces up to 600
+ *   large       50 sets of 50-400 cards, faces up to 1000
+ *   wide        10 sets of 100-200 cards, faces up to 10^6
+ *   sparse      20 sets of 24-32 cards, faces up to 10^9 (few splits exist)
+ *   sparse_big  4 sets of 44 cards, faces up to 10^8, built to split
+ * Prints one line: class, strategy, cases, milliseconds and a digest of
+ * the output (equal digests = equal answers). --print writes the input
+ * to stdout instead. A strategy can take hours where the cost model
+ * would not pick it: run_strategies.sh runs each under a timeout.
+ */
+
+#define P1346_NO_MAIN
+#include "../solution.cpp"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+static unsigned long long rngState = 88172645463325252ULL;
+
+static unsigned long long rnd()
+{
+  rngState ^= rngState << 13;
+  rngState ^= rngState >> 7;
+  rngState ^= rngState << 17;
+  return rngState;
+}
+
+static long long between(long long lo, long long hi)
+{
+  return lo + (long long)(rnd() % (unsigned long long)(hi - lo + 1));
+}
+
+static void randomSets(string &in, int sets, int minN, int maxN, long long maxFace)
+{
+  for (int t = 0; t < sets; ++t)
+  {
+    int n = (int)between(minN, maxN);
+    in += to_string(n) + "\n";
+    for (int i = 0; i < n; ++i)
+      in += to_string(between(0, maxFace)) + " " + to_string(between(0, maxFace)) + "\n";
+  }
+}
+
+// Sets of n cards with random signs chosen first: the last card's
+// difference cancels the others, so each set splits without a discard
+static void splittingSets(string &in, int sets, int n, long long maxFace)
+{
+  for (int t = 0; t < sets; ++t)
+  {
+    in += to_string(n) + "\n";
+    long long balance = 0;
+    for (int i = 0; i < n - 1; ++i)
+    {
+      long long a = between(0, maxFace), b = between(0, maxFace);
+      balance += (rnd() & 1) ? a - b : b - a;
+      in += to_string(a) + " " + to_string(b) + "\n";
+    }
+    long long small = between(0, maxFace);
+    in += to_string(small) + " " + to_string(small + llabs(balance)) + "\n";
+  }
+}
+
+// The input of a class; returns its number of sets (0: no such class)
+static int makeInput(const string &name, string &in)
+{
+  int sets = 0;
+  if (name == "small")
+    randomSets(in, sets = 2000, 1, 10, 600);
+  else if (name == "large")
+    randomSets(in, sets = 50, 50, 400, 1000);
+  else if (name == "wide")
+    randomSets(in, sets = 10, 100, 200, 1000000);
+  else if (name == "sparse")
+    randomSets(in, sets = 20, 24, 32, 1000000000);
+  else if (name == "sparse_big")
+    splittingSets(in, sets = 4, 44, 100000000);
+  in += "0\n";
+  return sets;
+}
+
+int main(int argc, char **argv)
+{
+  string input;
+  int cases = argc > 1 ? makeInput(argv[1], input) : 0;
+  if (!cases)
+  {
+    fprintf(stderr, "usage: bench_strategies <small|large|wide|sparse|sparse_big> "
+                    "[auto|dfs|bitset|mitm|ss | --print]\n");
+    return 2;
+  }
+  string name = argc > 2 ? argv[2] : "auto";
+  if (name == "--print")
+  {
+    fwrite(input.data(), 1, input.size(), stdout);
+    return 0;
+  }
+
+  static const char *NAMES[] = {"auto", "dfs", "bitset", "mitm", "ss"};
+  static ChildPlayEngine engine; // Static: keeps the stack small
+  int which = 0;
+  while (which < 5 && name != NAMES[which])
+    which++;
+  if (which == 5)
+  {
+    fprintf(stderr, "unknown strategy '%s'\n", name.c_str());
+    return 2;
+  }
+  engine.strategy = (Strategy)which;
+
+  auto t0 = chrono::steady_clock::now();
+  string out = engine.solve(input);
+  double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+
+  unsigned long long digest = 1469598103934665603ULL;
+  for (unsigned char c : out)
+    digest = (digest ^ c) * 1099511628211ULL;
+  printf("%-10s %-6s cases=%d %10.1f ms  digest=%016llx\n", argv[1], NAMES[which], cases, ms, digest);
+  return 0;
+}
@@ -0,0 +1,14 @@
+#!/bin/sh
+# Builds bench_strategies and runs every class x strategy in its own process.
+# A strategy the cost model would never pick can run for hours: each run
+# is cut at 60 s and reported as a timeout.
+# Usage: bench/run_strategies.sh
+set -e
+cd "$(dirname "$0")"
+mkdir -p bin
+g++ -O2 -std=c++17 -o bin/bench_strategies bench_strategies.cpp
+for class in small large wide sparse sparse_big; do
+  for strategy in auto dfs bitset mitm ss; do
+    timeout 60 ./bin/bench_strategies "$class" "$strategy" || echo "$class $strategy timeout"
+  done
+done
@@ -1,12 +1,39 @@
-#include <iostream>
 #include <vector>
 #include <algorithm>
 #include <numeric>
 #include <cmath>
+#include <climits>
+#include <cstring>
 #include <set>
+#include "../common/fastio.hpp"
+#include "../common/stats.hpp"
+#include "../common/engine.hpp"
 
 using namespace std;
 
+// Search statistics (common/stats.hpp), empty unless built with -DTCA_STATS:
+// root searches (1 + one per discard candidate tried), can_solve calls,
+// bound prunes, memo hits / inserts, the recursion depth, and how many
+// searches each strategy decided.
+enum
+{
+  C_SEARCHES,
+  C_CALLS,
+  C_PRUNED,
+  C_MEMO_HITS,
+  C_MEMO_INSERTS,
+  C_DFS,
+  C_BITSET,
+  C_MITM,
+  C_SS
+};
+enum
+{
+  H_DEPTH
+};
+
+typedef unsigned long long u64;
+
 // Documentation:
 // Structure to hold Slab details.
 struct Card
@@ -14,24 +41,86 @@ struct Card
   int v_small;
   int v_large;
   int v_diff;
-  int v_sum;
+  long long v_sum; // Two faces near 2^31 do not fit an int
   int original_index;
 };
 
-// Global storage to avoid reallocation
-vector<Card> cards;
-vector<int> suffix_sums;
-// Memoization: store visited states. Key = idx * 400000 + sum + offset
-// Using a set because array [400][800000] is too large (320MB integers).
-// Given strict memory, std::set<pair<int,int>> is safer.
-set<pair<int, int>> memo;
+// How one search ("can these cards be balanced?") is decided.
+// Balancing is a subset of the differences that sums to T = D / 2
+// (D = sum of the differences in play):
+//   DFS     can_solve(): pruned recursion with a memo of failed states
+//   BITSET  one bit per sum in [0, T]: reach |= reach << d, O(n * T / 64)
+//   MITM    sorted subset sums of each half, matched with two pointers:
+//           O(2^(n/2)) time and memory
+//   SS      Schroeppel-Shamir: each half is streamed in order from the
+//           sums of its two quarters through a heap: O(2^(n/2) log) time,
+//           O(2^(n/4)) memory
+enum Strategy
+{
+  AUTO, // The cost model picks per search
+  DFS,
+  BITSET,
+  MITM,
+  SS
+};
+
+// Cost model: worst-case work of one search, in nanoseconds (constants
+// measured with bench/bench_strategies.cpp). Strategies over the memory
+// budget are not considered; DFS is always available.
+const double NS_DFS_STATE = 250;  // One failed (idx, target) state: two calls + memo insert
+const double NS_DFS_CALL = 1000;  // One can_solve call, worst case (memo of millions of states)
+const double DFS_TRY_SHARE = 0.25; // Budget of a DFS try, as a share of the pick's cost
+const double NS_BITSET_WORD = 2;  // One shift-or of 64 sums
+const double NS_MITM_SUM = 9;     // One half-sum merged, then scanned
+const double NS_SS_SUM = 10;      // One half-sum through a heap, per log2 step
+const size_t MEMORY_BUDGET = 64u << 20; // 64 MB per search
+
+// Reentrant engine (common/engine.hpp). Fast I/O (common/fastio.hpp)
+struct ChildPlayEngine : ReentrantEngine<ChildPlayEngine>
+{
+  Stats stats{{"searches", "calls", "pruned", "memo_hits", "memo_inserts", "dfs", "bitset", "mitm", "ss"}, {"depth"}};
+
+  // Engine storage to avoid reallocation
+  vector<Card> cards;
+  vector<long long> suffix_sums;
+  // Memoization: store visited states. Key = idx * 400000 + sum + offset
+  // Using a set because array [400][800000] is too large (320MB integers).
+  // Given strict memory, std::set<pair<int,int>> is safer.
+  set<pair<int, long long>> memo;
+
+  Strategy strategy = AUTO; // Fixed strategy instead of the cost model (bench)
+  long long calls_left;     // DFS budget: the search gives up below 0
+  vector<int> items;        // Non-zero differences in play (BITSET, MITM, SS)
+  vector<u64> row;          // BITSET reachable sums
+  vector<long long> sums[4], scratch; // MITM halves / SS quarters
+  struct HeapEntry
+  {
+    long long sum;
+    int i, j; // sum = first[i] + second[j]
+  };
+  vector<HeapEntry> heapA, heapB; // SS streams
+
+  bool can_solve(int idx, long long target, int ignore_idx);
+  bool balanced(int ignore_idx);
+  Strategy choose(int ignore_idx, long long target, double &cost);
+  bool bitsetSum(long long target);
+  void subsetSums(int lo, int hi, vector<long long> &out);
+  bool mitmSum(long long target);
+  bool ssSum(long long target);
+  void run(BlockReader &reader, BufferedWriter &writer);
+};
 
 // Recursive Solver
 // idx: current card index we are deciding on
 // target: the balance we need to achieve (0)
 // ignore_idx: index of the card we decided to discard (or -1)
-bool can_solve(int idx, int target, int ignore_idx)
+bool ChildPlayEngine::can_solve(int idx, long long target, int ignore_idx)
 {
+  auto scope = stats.enter(H_DEPTH);
+  stats.add(C_CALLS);
+  if (--calls_left < 0)
+    return false; // Out of budget: not a failure, so nothing is memoized
+
   // 1. Base Case: No cards left
   if (idx < 0)
   {
@@ -50,14 +139,16 @@ bool can_solve(int idx, int target, int ignore_idx)
   // Note: If ignore_idx < idx, suffix_sums[idx] includes the ignored card,
   // making the bound slightly loose but still valid (valid upper bound).
   // For tighter bounds, we'd recalculate suffix sums, but this is usually sufficient.
-  if (abs(target) > suffix_sums[idx])
+  if (llabs(target) > suffix_sums[idx])
   {
+    stats.add(C_PRUNED);
     return false;
   }
 
   // 4. Memoization Check
   if (memo.count({idx, target}))
   {
+    stats.add(C_MEMO_HITS);
     return false; // Already visited this state and it failed
   }
 
@@ -71,11 +162,274 @@ bool can_solve(int idx, int target, int ignore_idx)
   if (can_solve(idx - 1, target + diff, ignore_idx))
     return true;
 
-  // 7. Mark failure
+  // 7. Mark failure (unless the budget cut the search short)
+  if (calls_left < 0)
+    return false;
   memo.insert({idx, target});
+  stats.add(C_MEMO_INSERTS);
   return false;
 }
 
+// 2^k, saturated (a cost, not an exact count)
+static double pow2(int k)
+{
+  return k >= 1000 ? 1e300 : ldexp(1.0, k);
+}
+
+// The cheapest strategy for balancing all cards but ignore_idx, given
+// T = target and the non-zero differences in 'items' (ascending); 'cost'
+// gets its estimate
+Strategy ChildPlayEngine::choose(int ignore_idx, long long target, double &cost)
+{
+  int n = (int)items.size();
+  Strategy best = DFS;
+
+  // DFS: at card idx the memo holds at most one state per reachable
+  // target, and there are at most 2^(cards above idx) of them
+  cost = 0;
+  for (int idx = (int)cards.size() - 1, above = 0; idx >= 0 && cost < 1e300; --idx)
+  {
+    if (idx == ignore_idx)
+      continue;
+    cost += min(pow2(above++), 2.0 * suffix_sums[idx] + 1);
+  }
+  cost *= NS_DFS_STATE;
+
+  // BITSET: item i shifts the words up to min(T, items[0] + ... + items[i])
+  double words = (double)target / 64 + 1;
+  if (words * sizeof(u64) <= MEMORY_BUDGET)
+  {
+    double shifted = 0, prefix = 0;
+    for (int d : items)
+    {
+      prefix += d;
+      shifted += min((double)target, prefix) / 64 + 1;
+    }
+    if (shifted * NS_BITSET_WORD < cost)
+    {
+      best = BITSET;
+      cost = shifted * NS_BITSET_WORD;
+    }
+  }
+
+  // MITM: building a half of 2^h sums merges 2^1 + ... + 2^h of them.
+  // Memory: both halves and one merge buffer
+  double half = pow2((n + 1) / 2);
+  if (3 * half * sizeof(long long) <= MEMORY_BUDGET && 4 * half * NS_MITM_SUM < cost)
+  {
+    best = MITM;
+    cost = 4 * half * NS_MITM_SUM;
+  }
+
+  // SS: up to 2^h steps per half, each through a heap of 2^(n/4) entries.
+  // Memory: four quarters, two heaps, one merge buffer
+  double quarter = pow2((n + 3) / 4);
+  double ssCost = 2 * half * max(1, (n + 3) / 4) * NS_SS_SUM;
+  if (7 * quarter * sizeof(HeapEntry) <= MEMORY_BUDGET && ssCost < cost)
+  {
+    best = SS;
+    cost = ssCost;
+  }
+  return best;
+}
+
+// Is there a subset of 'items' that sums to 'target'? One row of bits,
+// shifted in place from the top word down. The items are ascending, so
+// only the words up to the largest sum so far ('top') are shifted.
+bool ChildPlayEngine::bitsetSum(long long target)
+{
+  size_t words = (size_t)(target / 64) + 1;
+  u64 lastMask = (target % 64 == 63) ? ~0ULL : ((1ULL << (target % 64 + 1)) - 1);
+  row.assign(words, 0);
+  row[0] = 1;
+  long long top = 0;
+  for (int d : items)
+  {
+    top = min(target, top + d);
+    size_t ws = (size_t)d >> 6;
+    unsigned bs = d & 63;
+    for (size_t i = (size_t)(top >> 6) + 1; i-- > ws;)
+    {
+      u64 moved = row[i - ws] << bs;
+      if (bs && i > ws)
+        moved |= row[i - ws - 1] >> (64 - bs);
+      row[i] |= moved;
+    }
+    row[words - 1] &= lastMask;
+    if ((row[target >> 6] >> (target & 63)) & 1)
+      return true;
+  }
+  return (row[target >> 6] >> (target & 63)) & 1;
+}
+
+// Distinct subset sums of items[lo, hi), ascending. Adding an item merges
+// the list with itself shifted by that item: no sort needed.
+void ChildPlayEngine::subsetSums(int lo, int hi, vector<long long> &out)
+{
+  out.assign(1, 0);
+  for (int i = lo; i < hi; ++i)
+  {
+    long long x = items[i];
+    size_t m = out.size(), a = 0, b = 0;
+    scratch.resize(2 * m);
+    size_t k = 0;
+    while (a < m || b < m)
+    {
+      long long v = (b == m || (a < m && out[a] <= out[b] + x)) ? out[a++] : out[b++] + x;
+      if (k == 0 || scratch[k - 1] != v)
+        scratch[k++] = v;
+    }
+    scratch.resize(k);
+    out.swap(scratch);
+  }
+}
+
+// Subset sum by meet in the middle: the sums of the first half ascending
+// against those of the second half descending
+bool ChildPlayEngine::mitmSum(long long target)
+{
+  int n = (int)items.size();
+  subsetSums(0, n / 2, sums[0]);
+  subsetSums(n / 2, n, sums[1]);
+  const vector<long long> &L = sums[0], &R = sums[1];
+  size_t i = 0, j = R.size();
+  while (i < L.size() && j > 0)
+  {
+    long long s = L[i] + R[j - 1];
+    if (s == target)
+      return true;
+    if (s < target)
+      i++;
+    else
+      j--;
+  }
+  return false;
+}
+
+// Schroeppel-Shamir: the same two-pointer walk, but the half sums are
+// never stored. The first half is streamed ascending from its quarters
+// through a min-heap, the second descending through a max-heap.
+bool ChildPlayEngine::ssSum(long long target)
+{
+  int n = (int)items.size();
+  int q1 = n / 4, q2 = n / 2, q3 = n / 2 + (n - n / 2) / 2;
+  subsetSums(0, q1, sums[0]);
+  subsetSums(q1, q2, sums[1]);
+  subsetSums(q2, q3, sums[2]);
+  subsetSums(q3, n, sums[3]);
+  const vector<long long> &A1 = sums[0], &A2 = sums[1], &B1 = sums[2], &B2 = sums[3];
+
+  auto minFirst = [](const HeapEntry &x, const HeapEntry &y)
+  { return x.sum > y.sum; };
+  auto maxFirst = [](const HeapEntry &x, const HeapEntry &y)
+  { return x.sum < y.sum; };
+
+  // Heap A: A1[i] + A2[j], j rising; heap B: B1[i] + B2[j], j falling
+  heapA.clear();
+  heapB.clear();
+  for (int i = 0; i < (int)A1.size(); ++i)
+    heapA.push_back({A1[i] + A2[0], i, 0});
+  for (int i = 0; i < (int)B1.size(); ++i)
+    heapB.push_back({B1[i] + B2.back(), i, (int)B2.size() - 1});
+  make_heap(heapA.begin(), heapA.end(), minFirst);
+  make_heap(heapB.begin(), heapB.end(), maxFirst);
+
+  while (!heapA.empty() && !heapB.empty())
+  {
+    long long s = heapA.front().sum + heapB.front().sum;
+    if (s == target)
+      return true;
+    if (s < target)
+    {
+      // Next larger sum of the first half
+      pop_heap(heapA.begin(), heapA.end(), minFirst);
+      HeapEntry &e = heapA.back();
+      if (++e.j < (int)A2.size())
+      {
+        e.sum = A1[e.i] + A2[e.j];
+        push_heap(heapA.begin(), heapA.end(), minFirst);
+      }
+      else
+      {
+        heapA.pop_back();
+      }
+    }
+    else
+    {
+      // Next smaller sum of the second half
+      pop_heap(heapB.begin(), heapB.end(), maxFirst);
+      HeapEntry &e = heapB.back();
+      if (--e.j >= 0)
+      {
+        e.sum = B1[e.i] + B2[e.j];
+        push_heap(heapB.begin(), heapB.end(), maxFirst);
+      }
+      else
+      {
+        heapB.pop_back();
+      }
+    }
+  }
+  return false;
+}
+
+// Can all cards except ignore_idx (-1 = none) be balanced? The caller has
+// checked that their sum is even, and so is their difference D.
+bool ChildPlayEngine::balanced(int ignore_idx)
+{
+  stats.add(C_SEARCHES);
+  items.clear();
+  long long D = 0;
+  for (int i = 0; i < (int)cards.size(); ++i)
+  {
+    if (i != ignore_idx && cards[i].v_diff)
+    {
+      items.push_back(cards[i].v_diff);
+      D += cards[i].v_diff;
+    }
+  }
+  long long target = D / 2;
+
+  Strategy s = strategy;
+  calls_left = LLONG_MAX;
+  if (s == AUTO)
+  {
+    double cost;
+    s = choose(ignore_idx, target, cost);
+    if (s != DFS)
+    {
+      // The DFS bound is loose: pruning and early hits often end it far
+      // sooner. Try it first on DFS_TRY_SHARE of the pick's cost: a failed
+      // try then bounds the search at 1.25x the pick's cost.
+      memo.clear();
+      calls_left = (long long)min(cost * DFS_TRY_SHARE / NS_DFS_CALL, 1e18);
+      bool ok = can_solve((int)cards.size() - 1, 0, ignore_idx);
+      if (calls_left >= 0)
+      {
+        stats.add(C_DFS);
+        return ok;
+      }
+    }
+  }
+  switch (s)
+  {
+  case BITSET:
+    stats.add(C_BITSET);
+    return bitsetSum(target);
+  case MITM:
+    stats.add(C_MITM);
+    return mitmSum(target);
+  case SS:
+    stats.add(C_SS);
+    return ssSum(target);
+  default:
+    stats.add(C_DFS);
+    memo.clear();
+    calls_left = LLONG_MAX;
+    return can_solve((int)cards.size() - 1, 0, ignore_idx);
+  }
+}
+
 // Comparator for discarding strategy
 bool compareCardsForDiscard(const pair<Card, int> &a, const pair<Card, int> &b)
 {
@@ -88,23 +442,35 @@ bool compareCardsForDiscard(const pair<Card, int> &a, const pair<Card, int> &b)
   return a.first.v_small < b.first.v_small;
 }
 
-void solve()
+// "<half> discard <small> <large>"
+void writeDiscard(BufferedWriter &writer, long long half, const Card &c)
+{
+  writer.writeInt(half);
+  writer.write(" discard ");
+  writer.writeInt(c.v_small);
+  writer.put(' ');
+  writer.writeInt(c.v_large);
+  writer.put('\n');
+}
+
+void ChildPlayEngine::run(BlockReader &reader, BufferedWriter &writer)
 {
   int N;
-  while (cin >> N && N != 0)
+  while (reader.readInt(N) && N != 0)
   {
     cards.clear();
-    int total_sum_all = 0;
+    long long total_sum_all = 0;
 
     for (int i = 0; i < N; ++i)
     {
-      int u, v;
-      cin >> u >> v;
+      int u = 0, v = 0;
+      reader.readInt(u);
+      reader.readInt(v);
       Card c;
       c.v_small = min(u, v);
       c.v_large = max(u, v);
       c.v_diff = c.v_large - c.v_small;
-      c.v_sum = c.v_large + c.v_small;
+      c.v_sum = (long long)c.v_large + c.v_small;
       c.original_index = i;
       cards.push_back(c);
       total_sum_all += c.v_sum;
@@ -121,7 +487,7 @@ void solve()
     // Precompute Suffix Sums for Pruning
     // suffix_sums[i] = Sum(diff) for cards 0..i
     suffix_sums.resize(N);
-    int run_diff = 0;
+    long long run_diff = 0;
     for (int i = 0; i < N; ++i)
     {
       run_diff += cards[i].v_diff;
@@ -133,10 +499,10 @@ void solve()
     // 1. Try solving with NO discard
     if (total_sum_all % 2 == 0)
     {
-      memo.clear();
-      if (can_solve(N - 1, 0, -1))
+      if (balanced(-1))
       {
-        cout << total_sum_all / 2 << " discard none" << endl;
+        writer.writeInt(total_sum_all / 2);
+        writer.write(" discard none\n");
         solved = true;
       }
     }
@@ -158,7 +524,7 @@ void solve()
       {
         Card c = p.first;
         int idx_in_vec = p.second;
-        int remaining_sum = total_sum_all - c.v_sum;
+        long long remaining_sum = total_sum_all - c.v_sum;
 
         if (remaining_sum % 2 != 0)
           continue;
@@ -169,10 +535,9 @@ void solve()
         // Strict: if (abs(target) > suffix_sums[idx] - (idx >= ignore ? diff : 0))
         // The loose bound is usually fine. Let's use loose bound.
 
-        memo.clear();
-        if (can_solve(N - 1, 0, idx_in_vec))
+        if (balanced(idx_in_vec))
         {
-          cout << remaining_sum / 2 << " discard " << c.v_small << " " << c.v_large << endl;
+          writeDiscard(writer, remaining_sum / 2, c);
           solved = true;
           break;
         }
@@ -181,16 +546,22 @@ void solve()
 
     if (!solved)
     {
-      cout << "impossible" << endl;
+      writer.write("impossible\n");
     }
+    stats.endCase();
   }
 }
 
+#ifndef P1346_NO_MAIN
+
 int main()
 {
-  // Fast I/O
-  ios_base::sync_with_stdio(false);
-  cin.tie(NULL);
-  solve();
+  BlockReader reader;
+  BufferedWriter writer;
+  ChildPlayEngine engine;
+  engine.run(reader, writer);
+  writer.flush();
   return 0;
-}
\ No newline at end of file
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,581 @@
+/**
+ * Problem: Beecrowd 1346 - Child Play
+ * Method: Bitset Subset-Sum (word-parallel DP) + Checkpointed Reconstruction
+ * Language: C++17
+ *
+ * Replaces the std::set memo of solution.cpp with a dense reachability
+ * bitset. "Signs s_i such that sum(s_i * d_i) = 0" is the same question
+ * as "a subset of the d_i that sums to D / 2" (D = sum of all d_i), so
+ * one bit per reachable sum in [0, D / 2] is enough:
+ *
+ *      reach |= reach << d_i         (64 sums per machine word)
+ *
+ * Cost: O(N * D / 64) word operations per attempt.
+ *
+ * Memory budget (stated up front, MEMORY_BUDGET below):
+ *   Nothing is allocated before it is checked against the budget. The
+ *   split is reconstructed from the DP rows. If all N rows fit, they are
+ *   all kept. Otherwise only every k-th row is kept (checkpoints) and each
+ *   segment is recomputed once during the walk back, which costs at most
+ *   one extra forward pass. When even that does not fit (faces so large
+ *   that a few rows exceed the budget), the attempt falls back to meet in
+ *   the middle over the non-zero differences. Past that too, it throws
+ *   std::length_error: main() reports it and exits with 1.
+ *
+ * Discards ("knapsack with one deletion"):
+ *   Instead of one subset-sum per discard candidate, prefix rows
+ *   (cards 0..i-1) are stored and one mirrored suffix row sweeps back,
+ *   answering "discard card i" by combining prefix[i] with suffix[i+1].
+ *   Every candidate is decided in about two subset-sum passes. Above the
+ *   budget, a divide-and-conquer sweep keeps only O(log N) rows alive.
+ *
+ * Run with "--split" to also print, per test, one character per card in
+ * input order: '0' = as given, '1' = flipped, 'x' = discarded.
+ */
+
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include "../common/fastio.hpp"
+#include "../common/engine.hpp"
+
+using namespace std;
+
+typedef unsigned long long u64;
+
+// Upper bound on the bytes used by the DP rows (or the meet-in-the-middle
+// half sums) of one attempt.
+const size_t MEMORY_BUDGET = 64u << 20; // 64 MB
+
+// Documentation:
+// Structure to hold Slab details.
+struct Card
+{
+  int v_small;
+  int v_large;
+  int v_diff;
+  long long v_sum;
+  int original_index;
+  bool large_on_top; // Orientation as given in the input
+};
+
+// ---------------------------------------------------------------
+// Word bitset primitives
+// ---------------------------------------------------------------
+
+// dst = src | (src << shift), over 'words' words. Safe when dst == src:
+// we walk from the top word down, and each word only reads lower ones.
+void shiftOr(u64 *dst, const u64 *src, size_t words, size_t shift)
+{
+  size_t ws = shift >> 6;
+  unsigned bs = shift & 63;
+  for (size_t i = words; i-- > 0;)
+  {
+    u64 moved = 0;
+    if (i >= ws)
+    {
+      moved = src[i - ws] << bs;
+      if (bs && i > ws)
+        moved |= src[i - ws - 1] >> (64 - bs);
+    }
+    dst[i] = src[i] | moved;
+  }
+}
+
+inline bool testBit(const u64 *row, size_t bit)
+{
+  return (row[bit >> 6] >> (bit & 63)) & 1;
+}
+
+// ---------------------------------------------------------------
+// Subset-sum engine
+// ---------------------------------------------------------------
+
+struct HalfSum
+{
+  long long sum;
+  u64 mask; // Items of the half in the subset
+};
+
+// Every subset sum of items[idx[lo .. hi)], ascending
+void halfSums(const vector<int> &items, const vector<int> &idx, int lo, int hi, vector<HalfSum> &out)
+{
+  out.clear();
+  out.reserve((size_t)1 << (hi - lo));
+  out.push_back({0, 0});
+  for (int k = lo; k < hi; ++k)
+  {
+    size_t m = out.size();
+    for (size_t j = 0; j < m; ++j)
+      out.push_back({out[j].sum + items[idx[k]], out[j].mask | 1ULL << (k - lo)});
+  }
+  sort(out.begin(), out.end(), [](const HalfSum &a, const HalfSum &b)
+       { return a.sum < b.sum; });
+}
+
+// Subset sum by meet in the middle, for targets whose rows do not fit
+// MEMORY_BUDGET: the sums of each half of the non-zero items, the first
+// ascending against the second descending. Same contract as subsetSum().
+bool mitmSubsetSum(const vector<int> &items, long long target, vector<char> *pick)
+{
+  vector<int> idx; // Zero differences never change a sum
+  for (int i = 0; i < (int)items.size(); ++i)
+  {
+    if (items[i] != 0)
+      idx.push_back(i);
+  }
+  int m = (int)idx.size(), h = m / 2;
+  if (m - h > 32 || (((size_t)1 << h) + ((size_t)1 << (m - h))) * sizeof(HalfSum) > MEMORY_BUDGET)
+  {
+    throw length_error("bitset: subset sum to " + to_string(target) + " over " + to_string(m) +
+                       " cards exceeds MEMORY_BUDGET (" + to_string(MEMORY_BUDGET >> 20) + " MB)");
+  }
+
+  vector<HalfSum> L, R;
+  halfSums(items, idx, 0, h, L);
+  halfSums(items, idx, h, m, R);
+  size_t i = 0, j = R.size();
+  while (i < L.size() && j > 0)
+  {
+    long long sum = L[i].sum + R[j - 1].sum;
+    if (sum < target)
+    {
+      i++;
+    }
+    else if (sum > target)
+    {
+      j--;
+    }
+    else
+    {
+      if (pick)
+      {
+        pick->assign(items.size(), 0);
+        for (int k = 0; k < m; ++k)
+        {
+          u64 bit = k < h ? L[i].mask >> k : R[j - 1].mask >> (k - h);
+          (*pick)[idx[k]] = bit & 1;
+        }
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+// Is there a subset of 'items' (values in 'diffs') that sums to 'target'?
+// When 'pick' is given, it receives one flag per item: true = in subset.
+bool subsetSum(const vector<int> &items, long long target, vector<char> *pick)
+{
+  if (target < 0)
+    return false;
+
+  const size_t n = items.size();
+  const size_t words = (size_t)target / 64 + 1;
+  const size_t rowBytes = words * sizeof(u64);
+  const u64 lastMask = (target % 64 == 63) ? ~0ULL : ((1ULL << (target % 64 + 1)) - 1);
+
+  // Rows alive at once: the forward row, plus (to reconstruct) the
+  // n / stride + 1 checkpoints and one recomputed segment of stride rows.
+  // Take the smallest stride that fits (1: every row is kept).
+  const size_t maxRows = MEMORY_BUDGET / rowBytes;
+  size_t stride = 0;
+  if (!pick)
+  {
+    stride = maxRows >= 1 ? 1 : 0;
+  }
+  else
+  {
+    for (size_t st = 1; st <= n + 1 && !stride; ++st)
+    {
+      if (n / st + 1 + st + 1 <= maxRows)
+        stride = st;
+    }
+  }
+  if (stride == 0)
+    return mitmSubsetSum(items, target, pick);
+
+  // 1. Forward pass, saving row i (after i items) at every multiple of stride
+  size_t numCheckpoints = n / stride + 1;
+  vector<u64> checkpoints(pick ? numCheckpoints * words : 0);
+  vector<u64> cur(words, 0);
+  cur[0] = 1; // Sum 0 is reachable with no items
+
+  for (size_t i = 0; i <= n; ++i)
+  {
+    if (pick && i % stride == 0)
+      memcpy(&checkpoints[(i / stride) * words], cur.data(), rowBytes);
+    if (i == n)
+      break;
+    shiftOr(cur.data(), cur.data(), words, items[i]);
+    cur[words - 1] &= lastMask; // Sums above target are useless
+  }
+
+  if (!testBit(cur.data(), target))
+    return false;
+  if (!pick)
+    return true;
+
+  // 2. Walk back segment by segment.
+  // Item i (0-based) is in the subset iff sum s was NOT reachable before it.
+  pick->assign(n, 0);
+  vector<u64> segment(stride * words);
+  long long s = target;
+
+  for (size_t c = numCheckpoints; c-- > 0;)
+  {
+    size_t start = c * stride;
+    size_t end = min(n, start + stride);
+    if (start >= end)
+      continue;
+
+    // Rebuild rows start .. end-1 from the checkpoint
+    memcpy(segment.data(), &checkpoints[c * words], rowBytes);
+    for (size_t i = start + 1; i < end; ++i)
+    {
+      u64 *row = &segment[(i - start) * words];
+      shiftOr(row, row - words, words, items[i - 1]);
+      row[words - 1] &= lastMask;
+    }
+
+    for (size_t i = end; i-- > start;)
+    {
+      const u64 *before = &segment[(i - start) * words];
+      if (!testBit(before, s))
+      {
+        (*pick)[i] = 1;
+        s -= items[i];
+      }
+    }
+  }
+  return true;
+}
+
+// Comparator for discarding strategy
+bool compareCardsForDiscard(const Card &a, const Card &b)
+{
+  // Minimize total sum discarded (Maximize remaining)
+  if (a.v_sum != b.v_sum)
+    return a.v_sum < b.v_sum;
+  // Tie-breaker: Minimize the smaller face value
+  return a.v_small < b.v_small;
+}
+
+// ---------------------------------------------------------------
+// Engine
+// Reentrant (common/engine.hpp): the cards of the current test.
+// Fast I/O (common/fastio.hpp)
+// ---------------------------------------------------------------
+struct BitsetEngine : ReentrantEngine<BitsetEngine>
+{
+  vector<Card> cards;
+  bool printSplit = false; // Also print the split of every test ("--split")
+
+  bool balance(int skip, vector<char> *orient);
+  vector<char> discardFeasibility();
+  string describeSplit(const vector<char> &orient, int skip);
+  void run(BlockReader &reader, BufferedWriter &writer);
+};
+
+// Tries to balance all cards except 'skip' (-1 = none).
+// On success fills 'orient' per card: 1 = large on top, 0 = small on top.
+bool BitsetEngine::balance(int skip, vector<char> *orient)
+{
+  vector<int> items;
+  vector<int> owner;
+  long long total = 0;
+  for (int i = 0; i < (int)cards.size(); ++i)
+  {
+    if (i == skip)
+      continue;
+    items.push_back(cards[i].v_diff);
+    owner.push_back(i);
+    total += cards[i].v_diff;
+  }
+  if (total % 2 != 0)
+    return false;
+
+  vector<char> pick;
+  if (!subsetSum(items, total / 2, orient ? &pick : nullptr))
+    return false;
+
+  if (orient)
+  {
+    orient->assign(cards.size(), 0);
+    for (size_t k = 0; k < items.size(); ++k)
+      (*orient)[owner[k]] = pick[k];
+  }
+  return true;
+}
+
+// ---------------------------------------------------------------
+// Knapsack with one deletion: every discard in one sweep
+// ---------------------------------------------------------------
+
+// Does some x in [0, target] have prefix[x] AND suffix sum (target - x)?
+// 'rev' stores the suffix sums mirrored (sum s at bit maxSum - s), so the
+// question becomes an AND of 'pre' against 'rev' shifted by (maxSum - target).
+bool combine(const u64 *pre, const u64 *rev, size_t words, size_t maxSum, size_t target)
+{
+  size_t off = maxSum - target;
+  size_t ws = off >> 6;
+  unsigned bs = off & 63;
+  size_t last = target >> 6;
+  for (size_t w = 0; w <= last; ++w)
+  {
+    size_t src = w + ws;
+    u64 r = (src < words) ? rev[src] >> bs : 0;
+    if (bs && src + 1 < words)
+      r |= rev[src + 1] << (64 - bs);
+    u64 both = pre[w] & r;
+    if (w == last && (target & 63) != 63)
+      both &= (1ULL << ((target & 63) + 1)) - 1;
+    if (both)
+      return true;
+  }
+  return false;
+}
+
+// Fallback when the prefix rows exceed MEMORY_BUDGET: divide and conquer.
+// The row at 'level' holds every item outside [lo, hi). Recursing into
+// the left half copies it one level down and adds the right half; the
+// right half then reuses it after adding the left half. So each leaf i
+// sees all items except i, and 'rows' needs one row per level:
+// ceil(log2 N) + 1 rows, allocated once by the caller.
+void deletionDivide(const vector<int> &items, size_t lo, size_t hi, u64 *rows, size_t level,
+                    size_t words, u64 lastMask, const vector<long long> &targets, vector<char> &ok)
+{
+  u64 *row = rows + level * words;
+  if (hi - lo == 1)
+  {
+    ok[lo] = targets[lo] >= 0 && testBit(row, targets[lo]);
+    return;
+  }
+  size_t mid = (lo + hi) / 2;
+
+  u64 *left = row + words;
+  memcpy(left, row, words * sizeof(u64));
+  for (size_t i = mid; i < hi; ++i)
+  {
+    shiftOr(left, left, words, items[i]);
+    left[words - 1] &= lastMask;
+  }
+  deletionDivide(items, lo, mid, rows, level + 1, words, lastMask, targets, ok);
+
+  for (size_t i = lo; i < mid; ++i)
+  {
+    shiftOr(row, row, words, items[i]);
+    row[words - 1] &= lastMask;
+  }
+  deletionDivide(items, mid, hi, rows, level, words, lastMask, targets, ok);
+}
+
+// ok[i] = true iff all cards except card i can be balanced.
+// Main path: prefix rows (sums of cards 0..i-1) are stored, then one
+// mirrored suffix row sweeps back from the end, and card i is answered
+// by combining prefix[i] with suffix[i + 1]. Total: two subset-sum passes.
+vector<char> BitsetEngine::discardFeasibility()
+{
+  const size_t n = cards.size();
+  vector<int> items(n);
+  long long D = 0;
+  for (size_t i = 0; i < n; ++i)
+  {
+    items[i] = cards[i].v_diff;
+    D += items[i];
+  }
+
+  // Target when card i is discarded: half of the remaining difference
+  vector<long long> targets(n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    long long rest = D - items[i];
+    targets[i] = (rest % 2 == 0) ? rest / 2 : -1;
+  }
+
+  vector<char> ok(n, 0);
+  if (n == 0)
+    return ok;
+
+  const size_t maxSum = (size_t)(D / 2);
+  const size_t words = maxSum / 64 + 1;
+  const size_t rowBytes = words * sizeof(u64);
+  const u64 lastMask = (maxSum % 64 == 63) ? ~0ULL : ((1ULL << (maxSum % 64 + 1)) - 1);
+
+  // Rows each sweep keeps alive: n + 2 for prefix / suffix, one per
+  // level for the divide and conquer
+  size_t levels = 0;
+  while (((size_t)1 << levels) < n)
+    levels++;
+
+  if ((n + 2) * rowBytes > MEMORY_BUDGET)
+  {
+    // Neither sweep fits (or not even one row does): one attempt per
+    // candidate, each within the budget on its own (rows or meet in the
+    // middle)
+    if ((levels + 1) * rowBytes > MEMORY_BUDGET)
+    {
+      for (size_t i = 0; i < n; ++i)
+        ok[i] = targets[i] >= 0 && balance((int)i, nullptr);
+      return ok;
+    }
+    vector<u64> rows((levels + 1) * words, 0);
+    rows[0] = 1;
+    deletionDivide(items, 0, n, rows.data(), 0, words, lastMask, targets, ok);
+    return ok;
+  }
+
+  // 1. Prefix pass: prefix[i] = sums reachable with cards 0 .. i-1
+  vector<u64> prefix((n + 1) * words, 0);
+  prefix[0] = 1;
+  for (size_t i = 0; i < n; ++i)
+  {
+    shiftOr(&prefix[(i + 1) * words], &prefix[i * words], words, items[i]);
+    prefix[(i + 1) * words + words - 1] &= lastMask;
+  }
+
+  // 2. Suffix pass, mirrored: adding d moves sum s (bit maxSum - s) to
+  // bit maxSum - s - d, i.e. a right shift.
+  vector<u64> rev(words, 0);
+  rev[maxSum >> 6] |= 1ULL << (maxSum & 63);
+  for (size_t i = n; i-- > 0;)
+  {
+    // rev currently holds the sums of cards i+1 .. n-1
+    if (targets[i] >= 0)
+      ok[i] = combine(&prefix[i * words], rev.data(), words, maxSum, targets[i]);
+
+    size_t ws = items[i] >> 6;
+    unsigned bs = items[i] & 63;
+    for (size_t w = 0; w < words; ++w)
+    {
+      size_t src = w + ws;
+      u64 moved = (src < words) ? rev[src] >> bs : 0;
+      if (bs && src + 1 < words)
+        moved |= rev[src + 1] << (64 - bs);
+      rev[w] |= moved;
+    }
+  }
+  return ok;
+}
+
+// One character per card, in input order
+string BitsetEngine::describeSplit(const vector<char> &orient, int skip)
+{
+  string out(cards.size(), 'x');
+  for (const Card &c : cards)
+  {
+    int i = c.original_index;
+    if (i == skip)
+      continue;
+    out[i] = (orient[i] == c.large_on_top) ? '0' : '1';
+  }
+  return out;
+}
+
+// "<half> discard <small> <large>"
+void writeDiscard(BufferedWriter &writer, long long half, const Card &c)
+{
+  writer.writeInt(half);
+  writer.write(" discard ");
+  writer.writeInt(c.v_small);
+  writer.put(' ');
+  writer.writeInt(c.v_large);
+  writer.put('\n');
+}
+
+void BitsetEngine::run(BlockReader &reader, BufferedWriter &writer)
+{
+  int N;
+  while (reader.readInt(N) && N != 0)
+  {
+    cards.clear();
+    long long total_sum_all = 0;
+
+    for (int i = 0; i < N; ++i)
+    {
+      int u = 0, v = 0;
+      reader.readInt(u);
+      reader.readInt(v);
+      Card c;
+      c.v_small = min(u, v);
+      c.v_large = max(u, v);
+      c.v_diff = c.v_large - c.v_small;
+      c.v_sum = (long long)c.v_large + c.v_small;
+      c.original_index = i;
+      c.large_on_top = u >= v;
+      cards.push_back(c);
+      total_sum_all += c.v_sum;
+    }
+
+    vector<char> orient;
+    vector<char> *want = printSplit ? &orient : nullptr;
+
+    // 1. Try solving with NO discard
+    if (total_sum_all % 2 == 0 && balance(-1, want))
+    {
+      writer.writeInt(total_sum_all / 2);
+      writer.write(" discard none\n");
+      if (printSplit)
+      {
+        writer.write(describeSplit(orient, -1));
+        writer.put('\n');
+      }
+      continue;
+    }
+
+    // 2. Try discarding one card: one sweep answers every candidate,
+    // then the best-ranked feasible one wins.
+    vector<char> feasible = discardFeasibility();
+    vector<Card> candidates = cards;
+    sort(candidates.begin(), candidates.end(), compareCardsForDiscard);
+
+    bool solved = false;
+    for (const Card &c : candidates)
+    {
+      long long remaining_sum = total_sum_all - c.v_sum;
+      if (remaining_sum % 2 != 0 || !feasible[c.original_index])
+        continue;
+
+      if (!printSplit || balance(c.original_index, want))
+      {
+        writeDiscard(writer, remaining_sum / 2, c);
+        if (printSplit)
+        {
+          writer.write(describeSplit(orient, c.original_index));
+          writer.put('\n');
+        }
+        solved = true;
+        break;
+      }
+    }
+
+    if (!solved)
+      writer.write("impossible\n");
+  }
+}
+
+#ifndef BITSET_NO_MAIN
+
+int main(int argc, char **argv)
+{
+  BlockReader reader;
+  BufferedWriter writer;
+  BitsetEngine engine;
+  engine.printSplit = argc > 1 && string(argv[1]) == "--split";
+  try
+  {
+    engine.run(reader, writer);
+  }
+  catch (const length_error &e) // A case beyond MEMORY_BUDGET
+  {
+    fprintf(stderr, "%s\n", e.what());
+    return 1;
+  }
+  writer.flush();
+  return 0;
+}
+
+#endif
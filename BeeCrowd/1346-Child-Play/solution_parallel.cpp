@@ -0,0 +1,359 @@
+/**
+ * Problem: Beecrowd 1346 - Child Play
+ * Method: Pruned DFS (as solution.cpp) + Speculative Parallel Discards
+ * Language: C++17 (compile with -pthread)
+ *
+ * solution.cpp tries "no discard" and then each discard candidate one
+ * after another. The attempts are independent except for the shared
+ * global memo, so here every attempt is a task with its OWN memo:
+ *
+ *   rank 0      -> no discard
+ *   rank 1..N   -> discard candidates in compareCardsForDiscard order
+ *
+ * Workers take ranks in increasing order. When rank r succeeds, every
+ * running task with a rank above r is cancelled (its DFS polls a shared
+ * atomic), and no higher rank is started. Ranks below r are never
+ * cancelled, so the lowest successful rank, which is exactly the answer
+ * of the sequential loop, is always fully evaluated.
+ *
+ * The workers are started once (AttemptPool) and woken for each case.
+ * Small cases (few cards, or fewer than two ranks to try) are cheaper
+ * than the handover itself: they run in order on the calling thread.
+ *
+ * Usage: ./a.out [--threads K]   (default: hardware concurrency)
+ */
+
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <set>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <climits>
+#include <cstdlib>
+#include <string>
+#include "../common/fastio.hpp"
+#include "../common/engine.hpp"
+
+using namespace std;
+
+// Documentation:
+// Structure to hold Slab details.
+struct Card
+{
+  int v_small;
+  int v_large;
+  int v_diff;
+  int v_sum;
+  int original_index;
+};
+
+// Below this many cards a case runs sequentially: its attempts are too
+// short for the speculation to pay for waking the workers
+const int PARALLEL_MIN_CARDS = 40;
+
+// Per-task state: what solution.cpp keeps in globals
+struct Attempt
+{
+  int rank;
+  int ignore_idx;
+  set<pair<int, int>> memo;
+  bool cancelled = false;
+};
+
+// Comparator for discarding strategy
+bool compareCardsForDiscard(const pair<Card, int> &a, const pair<Card, int> &b)
+{
+  // Minimize total sum discarded (Maximize remaining)
+  if (a.first.v_sum != b.first.v_sum)
+    return a.first.v_sum < b.first.v_sum;
+  // Tie-breaker: Minimize the smaller face value
+  return a.first.v_small < b.first.v_small;
+}
+
+// Worker threads, started once and woken for each case. A case is the
+// sorted cards, their suffix sums and one 'ignore' list: ignore[r] = card
+// to skip at rank r (-1 = none), -2 = skip this rank. run() hands it over
+// by bumping 'epoch', works on it too, and returns when every worker is
+// done with it. The case stays read-only while the tasks run.
+class AttemptPool
+{
+public:
+  explicit AttemptPool(int threads)
+  {
+    for (int t = 1; t < threads; ++t)
+      workers.emplace_back([this]
+                           { loop(); });
+  }
+
+  ~AttemptPool()
+  {
+    {
+      lock_guard<mutex> lock(m);
+      stopping = true;
+    }
+    wake.notify_all();
+    for (thread &th : workers)
+      th.join();
+  }
+
+  // Runs all ranked attempts; returns the winning rank (or INT_MAX)
+  int run(const vector<Card> &sorted, const vector<int> &sums, const vector<int> &ignore, bool parallel)
+  {
+    best_rank.store(INT_MAX);
+    next_rank.store(0);
+    cards = &sorted;
+    suffix_sums = &sums;
+    job = &ignore;
+    if (!parallel || workers.empty())
+    {
+      work();
+      return best_rank.load();
+    }
+
+    {
+      lock_guard<mutex> lock(m);
+      ++epoch;
+      busy = (int)workers.size();
+    }
+    wake.notify_all();
+    work(); // The calling thread works too
+    unique_lock<mutex> lock(m);
+    done.wait(lock, [this]
+              { return busy == 0; });
+    return best_rank.load();
+  }
+
+private:
+  vector<thread> workers;
+  mutex m;
+  condition_variable wake, done;
+  unsigned long long epoch = 0; // Bumped once per parallel case
+  int busy = 0;                 // Workers still on the current case
+  bool stopping = false;
+
+  const vector<Card> *cards = nullptr;
+  const vector<int> *suffix_sums = nullptr;
+  const vector<int> *job = nullptr;
+  atomic<int> next_rank{0};
+  atomic<int> best_rank{INT_MAX}; // Lowest rank that succeeded so far (INT_MAX = none yet)
+
+  void loop()
+  {
+    unsigned long long seen = 0;
+    while (true)
+    {
+      {
+        unique_lock<mutex> lock(m);
+        wake.wait(lock, [&]
+                  { return stopping || epoch != seen; });
+        if (stopping)
+          return;
+        seen = epoch;
+      }
+      work();
+      lock_guard<mutex> lock(m);
+      if (--busy == 0)
+        done.notify_one();
+    }
+  }
+
+  void work()
+  {
+    const vector<int> &ignore = *job;
+    int total = (int)ignore.size();
+    while (true)
+    {
+      int r = next_rank.fetch_add(1);
+      // Ranks are handed out in order: once one is past the best, all are.
+      if (r >= total || r > best_rank.load())
+        return;
+      if (ignore[r] == -2)
+        continue;
+
+      Attempt at;
+      at.rank = r;
+      at.ignore_idx = ignore[r];
+      if (can_solve(at, (int)cards->size() - 1, 0))
+        publish(r);
+    }
+  }
+
+  // Recursive Solver (same logic as solution.cpp, memo owned by the attempt)
+  // idx: current card index we are deciding on
+  // target: the balance we need to achieve (0)
+  bool can_solve(Attempt &at, int idx, int target)
+  {
+    // 0. Cancellation: a better-ranked attempt already succeeded
+    if (best_rank.load(memory_order_relaxed) < at.rank)
+    {
+      at.cancelled = true;
+      return false;
+    }
+
+    // 1. Base Case: No cards left
+    if (idx < 0)
+      return target == 0;
+
+    // 2. Skip ignored card
+    if (idx == at.ignore_idx)
+      return can_solve(at, idx - 1, target);
+
+    // 3. Pruning (Bounding)
+    if (abs(target) > (*suffix_sums)[idx])
+      return false;
+
+    // 4. Memoization Check
+    if (at.memo.count({idx, target}))
+      return false;
+
+    int diff = (*cards)[idx].v_diff;
+
+    // 5. Try Subtracting / Adding Difference
+    if (can_solve(at, idx - 1, target - diff))
+      return true;
+    if (at.cancelled)
+      return false;
+    if (can_solve(at, idx - 1, target + diff))
+      return true;
+    if (at.cancelled)
+      return false;
+
+    // 6. Mark failure
+    at.memo.insert({idx, target});
+    return false;
+  }
+
+  // Lowers best_rank to 'rank' if it is better
+  void publish(int rank)
+  {
+    int cur = best_rank.load();
+    while (rank < cur && !best_rank.compare_exchange_weak(cur, rank))
+    {
+    }
+  }
+};
+
+// "<half> discard <small> <large>"
+void writeDiscard(BufferedWriter &writer, int half, const Card &c)
+{
+  writer.writeInt(half);
+  writer.write(" discard ");
+  writer.writeInt(c.v_small);
+  writer.put(' ');
+  writer.writeInt(c.v_large);
+  writer.put('\n');
+}
+
+// Reentrant engine (common/engine.hpp): the cards of the current case
+// and the pool, whose workers live as long as the engine.
+// Fast I/O (common/fastio.hpp)
+struct ParallelEngine : ReentrantEngine<ParallelEngine>
+{
+  vector<Card> cards;
+  vector<int> suffix_sums;
+  vector<pair<Card, int>> candidates;
+  vector<int> ignore;
+  AttemptPool pool;
+
+  explicit ParallelEngine(int threads = max(1u, thread::hardware_concurrency())) : pool(threads) {}
+
+  void run(BlockReader &reader, BufferedWriter &writer);
+};
+
+void ParallelEngine::run(BlockReader &reader, BufferedWriter &writer)
+{
+  int N;
+  while (reader.readInt(N) && N != 0)
+  {
+    cards.clear();
+    int total_sum_all = 0;
+
+    for (int i = 0; i < N; ++i)
+    {
+      int u = 0, v = 0;
+      reader.readInt(u);
+      reader.readInt(v);
+      Card c;
+      c.v_small = min(u, v);
+      c.v_large = max(u, v);
+      c.v_diff = c.v_large - c.v_small;
+      c.v_sum = c.v_large + c.v_small;
+      c.original_index = i;
+      cards.push_back(c);
+      total_sum_all += c.v_sum;
+    }
+
+    // Same ordering and bounds as solution.cpp
+    sort(
+        cards.begin(),
+        cards.end(),
+        [](const Card &a, const Card &b)
+        { return a.v_diff < b.v_diff; });
+
+    suffix_sums.resize(N);
+    int run_diff = 0;
+    for (int i = 0; i < N; ++i)
+    {
+      run_diff += cards[i].v_diff;
+      suffix_sums[i] = run_diff;
+    }
+
+    candidates.clear();
+    for (int i = 0; i < N; ++i)
+      candidates.push_back({cards[i], i});
+    sort(candidates.begin(), candidates.end(), compareCardsForDiscard);
+
+    // Rank 0: no discard. Ranks 1..N: candidates. Odd totals are skipped.
+    ignore.resize(N + 1);
+    ignore[0] = (total_sum_all % 2 == 0) ? -1 : -2;
+    int ranks = ignore[0] != -2;
+    for (int k = 0; k < N; ++k)
+    {
+      int remaining_sum = total_sum_all - candidates[k].first.v_sum;
+      ignore[k + 1] = (remaining_sum % 2 == 0) ? candidates[k].second : -2;
+      ranks += ignore[k + 1] != -2;
+    }
+
+    int win = pool.run(cards, suffix_sums, ignore, N >= PARALLEL_MIN_CARDS && ranks > 1);
+
+    if (win == 0)
+    {
+      writer.writeInt(total_sum_all / 2);
+      writer.write(" discard none\n");
+    }
+    else if (win != INT_MAX)
+    {
+      const Card &c = candidates[win - 1].first;
+      writeDiscard(writer, (total_sum_all - c.v_sum) / 2, c);
+    }
+    else
+    {
+      writer.write("impossible\n");
+    }
+  }
+}
+
+#ifndef PARALLEL_NO_MAIN
+
+int main(int argc, char **argv)
+{
+  int threads = max(1u, thread::hardware_concurrency());
+  for (int i = 1; i + 1 < argc; ++i)
+  {
+    if (string(argv[i]) == "--threads")
+      threads = max(1, atoi(argv[i + 1]));
+  }
+
+  BlockReader reader;
+  BufferedWriter writer;
+  ParallelEngine engine(threads);
+  engine.run(reader, writer);
+  writer.flush();
+  return 0;
+}
+
+#endif
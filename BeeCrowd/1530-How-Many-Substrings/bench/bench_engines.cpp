@@ -0,0 +1,104 @@
+/**
+ * Benchmark / driver: the three 1530 engines behind one flag.
+ *
+ * Usage: bench_engines --engine <sam|ukkonen|sa> < input > output
+ * Reads the judge input format, answers it with the chosen engine and
+ * prints the engine's wall time and max RSS to stderr. run_engines.sh
+ * feeds the same inputs to all three and checks that outputs agree.
+ *
+ * Each solution file is included in its own namespace (their globals and
+ * helpers share names). Every header they use is included first, so the
+ * includes inside the namespaces are no-ops. That includes
+ * common/fastio.hpp and Arena (common/arena.hpp), which both the SAM and
+ * Ukkonen use. All three are reentrant engines (common/engine.hpp): the
+ * chosen one is handed a stdin reader and a stdout writer.
+ */
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <array>
+#include <algorithm>
+#include <numeric>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <chrono>
+#include <stdexcept>
+#include "../../common/arena.hpp"
+#include "../../common/fastio.hpp"
+#include "../../common/engine.hpp"
+#include "../../common/stats.hpp"
+
+namespace sam_engine
+{
+#define SAM_NO_MAIN
+#include "../solution_SAM.cpp"
+}
+
+namespace ukkonen_engine
+{
+#define UKKONEN_NO_MAIN
+#include "../solution_Ukkonen.cpp"
+}
+
+namespace sa_engine
+{
+#define SA_NO_MAIN
+#include "../solution_SA.cpp"
+}
+
+using namespace std;
+
+int main(int argc, char **argv)
+{
+  string engine;
+  for (int i = 1; i + 1 < argc; ++i)
+  {
+    if (string(argv[i]) == "--engine")
+      engine = argv[i + 1];
+  }
+
+  auto t0 = chrono::steady_clock::now();
+  BlockReader reader;
+  BufferedWriter writer;
+  try
+  {
+    if (engine == "sam")
+    {
+      sam_engine::SubstringsEngine sam;
+      sam.run(reader, writer);
+    }
+    else if (engine == "ukkonen")
+    {
+      ukkonen_engine::SuffixTreeEngine ukkonen;
+      ukkonen.run(reader, writer);
+    }
+    else if (engine == "sa")
+    {
+      sa_engine::SuffixArrayEngine sa;
+      sa.run(reader, writer);
+    }
+    else
+    {
+      fprintf(stderr, "usage: %s --engine <sam|ukkonen|sa>\n", argv[0]);
+      return 1;
+    }
+  }
+  catch (const exception &e)
+  {
+    fprintf(stderr, "%s: %s\n", engine.c_str(), e.what());
+    return 1;
+  }
+  writer.flush();
+  fflush(stdout);
+  double secs = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+
+  struct rusage ru;
+  getrusage(RUSAGE_SELF, &ru);
+  fprintf(stderr, "%-8s %8.3f s  maxrss=%ld KB\n", engine.c_str(), secs, ru.ru_maxrss);
+  return 0;
+}
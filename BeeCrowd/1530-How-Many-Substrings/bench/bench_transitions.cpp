@@ -0,0 +1,95 @@
+/**
+ * Benchmark: SAM transition policies (DenseTransitions / SmallVecTransitions /
+ * HashTransitions) on three workloads.
+ *
+ * Usage: bench_transitions <dense|smallvec|hash> <random|unary|fibonacci> [n] [reps]
+ * Prints one line: policy, workload, n, chars/second, distinct substrings, max RSS.
+ * Run one policy per process so that RSS belongs to that policy alone
+ * (see run_transitions.sh).
+ */
+
+#define SAM_NO_MAIN
+#include "../solution_SAM.cpp"
+
+#include <chrono>
+#include <string>
+#include <cstdlib>
+#include <sys/resource.h>
+
+// Deterministic workloads (fixed seed)
+string makeWorkload(const string &kind, int n)
+{
+  string s;
+  s.reserve(n);
+  if (kind == "unary")
+  {
+    s.assign(n, 'a');
+  }
+  else if (kind == "fibonacci")
+  {
+    // F1 = "b", F2 = "a", F(k) = F(k-1) + F(k-2): the classic worst case for clones
+    string a = "b", b = "a";
+    while ((int)b.size() < n)
+    {
+      string c = b + a;
+      a.swap(b);
+      b.swap(c);
+    }
+    s = b.substr(0, n);
+  }
+  else
+  {
+    unsigned long long x = 88172645463325252ULL;
+    for (int i = 0; i < n; ++i)
+    {
+      x ^= x << 13;
+      x ^= x >> 7;
+      x ^= x << 17;
+      s.push_back(char('a' + x % ALPHABET));
+    }
+  }
+  return s;
+}
+
+template <class Transitions>
+void run(const char *policy, const string &kind, int n, int reps)
+{
+  static SAM<Transitions> sam; // Static: too large for the stack
+  string s = makeWorkload(kind, n);
+
+  auto t0 = chrono::steady_clock::now();
+  long long total = 0;
+  for (int r = 0; r < reps; ++r)
+  {
+    sam.init();
+    for (char c : s)
+      sam.extend(c);
+    total = sam.total_substrings;
+  }
+  double secs = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+
+  struct rusage ru;
+  getrusage(RUSAGE_SELF, &ru);
+  printf("%-9s %-10s n=%d  %8.2f Mchar/s  substrings=%lld  maxrss=%ld KB\n",
+         policy, kind.c_str(), n, (double)n * reps / secs / 1e6, total, ru.ru_maxrss);
+}
+
+int main(int argc, char **argv)
+{
+  if (argc < 3)
+  {
+    fprintf(stderr, "usage: %s <dense|smallvec|hash> <random|unary|fibonacci> [n] [reps]\n", argv[0]);
+    return 1;
+  }
+  string policy = argv[1], kind = argv[2];
+  int n = argc > 3 ? atoi(argv[3]) : 300000;
+  int reps = argc > 4 ? atoi(argv[4]) : 5;
+
+  if (policy == "dense")
+    run<DenseTransitions>("dense", kind, n, reps);
+  else if (policy == "smallvec")
+    run<SmallVecTransitions>("smallvec", kind, n, reps);
+  else
+    run<HashTransitions>("hash", kind, n, reps);
+  return 0;
+}
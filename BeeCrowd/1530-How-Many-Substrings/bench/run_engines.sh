@@ -0,0 +1,29 @@
+#!/bin/sh
+# Runs the three 1530 engines (SAM, Ukkonen, SA) on the same inputs and
+# checks that their outputs agree.
+# Usage: bench/run_engines.sh [long_len]
+set -e
+cd "$(dirname "$0")"
+mkdir -p bin
+LONG=${1:-2000000}
+g++ -O2 -std=c++17 -o bin/bench_engines bench_engines.cpp
+
+# Deterministic inputs: name, then an awk program printing the lines
+gen()
+{
+  awk -v long="$LONG" "BEGIN { srand(1530); $2 }" > "bin/engines_$1.in"
+}
+LETTER='substr("abcdefghijklmnopqrstuvwxyz", int(rand() * 26) + 1, 1)'
+ABCD='substr("abcd", int(rand() * 4) + 1, 1)'
+gen random_long "for (i = 1; i <= long; i++) { printf \"%s\", $LETTER; if (i % 1000 == 0) printf \"?\" } print \"\""
+gen abcd_long "for (i = 1; i <= long; i++) { printf \"%s\", $ABCD; if (i % 1000 == 0) printf \"?\" } print \"\""
+gen short_lines "for (k = 0; k < long / 10; k++) { n = int(rand() * 20) + 1; for (i = 0; i < n; i++) printf \"%s\", $LETTER; print \"?\" }"
+
+for input in random_long abcd_long short_lines; do
+  echo "== $input"
+  for engine in sam ukkonen sa; do
+    ./bin/bench_engines --engine $engine < bin/engines_$input.in > bin/engines_$input.$engine.out
+  done
+  cmp bin/engines_$input.sam.out bin/engines_$input.ukkonen.out
+  cmp bin/engines_$input.sam.out bin/engines_$input.sa.out
+done
@@ -0,0 +1,30 @@
+#!/bin/sh
+# Mixed workload for the per-line reset: one long line, then many short ones.
+# Every reset used to clear every node of the previous line, so the short
+# lines paid for the long one.
+# Usage: bench/run_reset.sh [long_len] [short_lines]
+set -e
+cd "$(dirname "$0")"
+mkdir -p bin
+LONG=${1:-200000}
+SHORT=${2:-200000}
+g++ -O2 -std=c++17 -o bin/solution_SAM ../solution_SAM.cpp
+g++ -O2 -std=c++17 -o bin/solution_Ukkonen ../solution_Ukkonen.cpp
+awk -v long="$LONG" -v short="$SHORT" 'BEGIN {
+  srand(1530);
+  line = "";
+  for (i = 0; i < long; i++) line = line substr("abcdefghijklmnopqrstuvwxyz", int(rand() * 26) + 1, 1);
+  print line "?";
+  for (k = 0; k < short; k++) {
+    line = "";
+    n = int(rand() * 8) + 1;
+    for (i = 0; i < n; i++) line = line substr("abcdefghijklmnopqrstuvwxyz", int(rand() * 26) + 1, 1);
+    print line "?";
+  }
+}' > bin/mixed.in
+for engine in solution_SAM solution_Ukkonen; do
+  start=$(date +%s%N)
+  ./bin/$engine < bin/mixed.in > bin/$engine.out
+  end=$(date +%s%N)
+  echo "$engine $(((end - start) / 1000000)) ms"
+done
@@ -0,0 +1,12 @@
+#!/bin/sh
+# Builds bench_transitions and runs every policy x workload in its own process.
+# Usage: bench/run_transitions.sh [n] [reps]
+set -e
+cd "$(dirname "$0")"
+mkdir -p bin
+g++ -O2 -std=c++17 -o bin/bench_transitions bench_transitions.cpp
+for workload in random unary fibonacci; do
+  for policy in dense smallvec hash; do
+    ./bin/bench_transitions "$policy" "$workload" "$@"
+  done
+done
@@ -0,0 +1,367 @@
+/**
+ * Problem: Beecrowd 1530 - How Many Substrings?
+ * Method: Suffix Array (SA-IS) + LCP (Kasai), offline per line
+ * Language: C++
+ *
+ * The other two engines are online. This one waits for the whole line,
+ * then answers every '?' from flat int arrays:
+ * 1. Reverse the line: the prefix of length i becomes the suffix
+ *    r[n - i ..]. Distinct substrings are the same in both directions.
+ * 2. Build the suffix array of r with SA-IS and its LCP array with Kasai.
+ * 3. Distinct substrings of a set of suffixes = sum of lengths minus the
+ *    LCP of each one with its rank predecessor. Start from all suffixes
+ *    of r and delete r[0..], r[1..], ... from a linked list over ranks:
+ *    each deletion removes (n - j) - max(lcp with both neighbours), and
+ *    the neighbours' LCP becomes the min of the two. What remains after
+ *    deleting j suffixes is exactly the answer for the prefix of length
+ *    n - j.
+ * Everything is O(n) per line.
+ */
+
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <cstdio>
+#include "../common/fastio.hpp"
+#include "../common/engine.hpp"
+
+using namespace std;
+
+// Tiny inputs: sort the suffixes directly
+vector<int> sa_naive(const vector<int> &s)
+{
+  int n = (int)s.size();
+  vector<int> sa(n);
+  iota(sa.begin(), sa.end(), 0);
+  sort(sa.begin(), sa.end(), [&](int l, int r)
+       {
+         if (l == r)
+           return false;
+         while (l < n && r < n)
+         {
+           if (s[l] != s[r])
+             return s[l] < s[r];
+           l++;
+           r++;
+         }
+         return l == n;
+       });
+  return sa;
+}
+
+// Small inputs: prefix doubling, ranks of length 2k from ranks of length k
+vector<int> sa_doubling(const vector<int> &s)
+{
+  int n = (int)s.size();
+  vector<int> sa(n), rnk = s, tmp(n);
+  iota(sa.begin(), sa.end(), 0);
+  for (int k = 1; k < n; k *= 2)
+  {
+    auto cmp = [&](int x, int y)
+    {
+      if (rnk[x] != rnk[y])
+        return rnk[x] < rnk[y];
+      int rx = x + k < n ? rnk[x + k] : -1;
+      int ry = y + k < n ? rnk[y + k] : -1;
+      return rx < ry;
+    };
+    sort(sa.begin(), sa.end(), cmp);
+    tmp[sa[0]] = 0;
+    for (int i = 1; i < n; i++)
+      tmp[sa[i]] = tmp[sa[i - 1]] + (cmp(sa[i - 1], sa[i]) ? 1 : 0);
+    swap(tmp, rnk);
+  }
+  return sa;
+}
+
+// SA-IS (Nong, Zhang, Chan): suffix array of s, with s[i] in [0, upper].
+// Short strings (every short line, and the deep levels of the recursion)
+// are cheaper with the simple sorts: SA-IS pays a dozen allocations.
+const int THRESHOLD_NAIVE = 10;
+const int THRESHOLD_DOUBLING = 40;
+
+vector<int> sa_is(const vector<int> &s, int upper)
+{
+  int n = (int)s.size();
+  if (n == 0)
+    return {};
+  if (n == 1)
+    return {0};
+  if (n == 2)
+    return s[0] < s[1] ? vector<int>{0, 1} : vector<int>{1, 0};
+  if (n < THRESHOLD_NAIVE)
+    return sa_naive(s);
+  if (n < THRESHOLD_DOUBLING)
+    return sa_doubling(s);
+
+  vector<int> sa(n);
+
+  // 1. Types: ls[i] = true for S-type (suffix i < suffix i + 1)
+  vector<bool> ls(n);
+  for (int i = n - 2; i >= 0; i--)
+    ls[i] = (s[i] == s[i + 1]) ? ls[i + 1] : (s[i] < s[i + 1]);
+
+  // 2. Bucket starts: L-types first, then S-types, per character
+  vector<int> sum_l(upper + 1), sum_s(upper + 1);
+  for (int i = 0; i < n; i++)
+  {
+    if (!ls[i])
+      sum_s[s[i]]++;
+    else
+      sum_l[s[i] + 1]++;
+  }
+  for (int i = 0; i <= upper; i++)
+  {
+    sum_s[i] += sum_l[i];
+    if (i < upper)
+      sum_l[i + 1] += sum_s[i];
+  }
+
+  // 3. Induced sort from a given order of LMS suffixes
+  auto induce = [&](const vector<int> &lms)
+  {
+    fill(sa.begin(), sa.end(), -1);
+    vector<int> buf(upper + 1);
+    copy(sum_s.begin(), sum_s.end(), buf.begin());
+    for (int d : lms)
+    {
+      if (d == n)
+        continue;
+      sa[buf[s[d]]++] = d;
+    }
+    copy(sum_l.begin(), sum_l.end(), buf.begin());
+    sa[buf[s[n - 1]]++] = n - 1;
+    for (int i = 0; i < n; i++)
+    {
+      int v = sa[i];
+      if (v >= 1 && !ls[v - 1])
+        sa[buf[s[v - 1]]++] = v - 1;
+    }
+    copy(sum_l.begin(), sum_l.end(), buf.begin());
+    for (int i = n - 1; i >= 0; i--)
+    {
+      int v = sa[i];
+      if (v >= 1 && ls[v - 1])
+        sa[--buf[s[v - 1] + 1]] = v - 1;
+    }
+  };
+
+  // 4. LMS positions (S-type right after an L-type)
+  vector<int> lms_map(n + 1, -1);
+  int m = 0;
+  for (int i = 1; i < n; i++)
+  {
+    if (!ls[i - 1] && ls[i])
+      lms_map[i] = m++;
+  }
+  vector<int> lms;
+  lms.reserve(m);
+  for (int i = 1; i < n; i++)
+  {
+    if (!ls[i - 1] && ls[i])
+      lms.push_back(i);
+  }
+
+  induce(lms);
+
+  // 5. Name the LMS substrings; recurse if two of them share a name
+  if (m)
+  {
+    vector<int> sorted_lms;
+    sorted_lms.reserve(m);
+    for (int v : sa)
+    {
+      if (lms_map[v] != -1)
+        sorted_lms.push_back(v);
+    }
+
+    vector<int> rec_s(m);
+    int rec_upper = 0;
+    rec_s[lms_map[sorted_lms[0]]] = 0;
+    for (int i = 1; i < m; i++)
+    {
+      int l = sorted_lms[i - 1], r = sorted_lms[i];
+      int end_l = (lms_map[l] + 1 < m) ? lms[lms_map[l] + 1] : n;
+      int end_r = (lms_map[r] + 1 < m) ? lms[lms_map[r] + 1] : n;
+      bool same = true;
+      if (end_l - l != end_r - r)
+      {
+        same = false;
+      }
+      else
+      {
+        while (l < end_l)
+        {
+          if (s[l] != s[r])
+            break;
+          l++;
+          r++;
+        }
+        if (l == n || s[l] != s[r])
+          same = false;
+      }
+      if (!same)
+        rec_upper++;
+      rec_s[lms_map[sorted_lms[i]]] = rec_upper;
+    }
+
+    vector<int> rec_sa = sa_is(rec_s, rec_upper);
+    for (int i = 0; i < m; i++)
+      sorted_lms[i] = lms[rec_sa[i]];
+    induce(sorted_lms);
+  }
+  return sa;
+}
+
+// Kasai: lcp[i] = LCP of suffixes sa[i] and sa[i + 1]
+void kasai(const vector<int> &s, const vector<int> &sa, vector<int> &rnk, vector<int> &lcp)
+{
+  int n = (int)s.size();
+  rnk.resize(n);
+  for (int i = 0; i < n; i++)
+    rnk[sa[i]] = i;
+
+  lcp.resize(max(n - 1, 0));
+  int h = 0;
+  for (int i = 0; i < n; i++)
+  {
+    if (h > 0)
+      h--;
+    if (rnk[i] == 0)
+      continue;
+    int j = sa[rnk[i] - 1];
+    while (j + h < n && i + h < n && s[j + h] == s[i + h])
+      h++;
+    lcp[rnk[i] - 1] = h;
+  }
+}
+
+// Reentrant engine (common/engine.hpp): the per-line buffers are
+// members, reused so that short lines do not pay for allocations
+struct SuffixArrayEngine : ReentrantEngine<SuffixArrayEngine>
+{
+  vector<int> r, rnk, lcp, prv, nxt, lcp_next;
+  vector<long long> distinct;
+  vector<int> line;
+  vector<int> queries; // Prefix length at each '?'
+
+  const vector<long long> &prefixDistinct();
+  void flushLine(BufferedWriter &writer);
+  void run(BlockReader &reader, BufferedWriter &writer);
+};
+
+// distinct[i] = number of distinct substrings of line[0 .. i), i = 0..n
+const vector<long long> &SuffixArrayEngine::prefixDistinct()
+{
+  int n = (int)line.size();
+  distinct.assign(n + 1, 0);
+  if (n == 0)
+    return distinct;
+
+  // 1. Reverse: prefixes of the line are suffixes of r
+  r.assign(line.rbegin(), line.rend());
+
+  // 2. Suffix array + LCP
+  vector<int> sa = sa_is(r, 25);
+  kasai(r, sa, rnk, lcp);
+
+  // 3. All suffixes present: the whole line
+  long long total = (long long)n * (n + 1) / 2;
+  for (int h : lcp)
+    total -= h;
+  distinct[n] = total;
+
+  // Linked list over ranks; lcp_next[x] = LCP of x and its current successor
+  prv.resize(n);
+  nxt.resize(n);
+  lcp_next.assign(n, 0);
+  for (int x = 0; x < n; x++)
+  {
+    prv[x] = x - 1;
+    nxt[x] = x + 1 < n ? x + 1 : -1;
+    if (x + 1 < n)
+      lcp_next[x] = lcp[x];
+  }
+
+  // 4. Delete r[j..] for j = 0, 1, ...: what is left is line[0 .. n - j - 1)
+  for (int j = 0; j < n - 1; j++)
+  {
+    int x = rnk[j];
+    int p = prv[x], q = nxt[x];
+    int a = p != -1 ? lcp_next[p] : 0; // LCP with the predecessor
+    int b = q != -1 ? lcp_next[x] : 0; // LCP with the successor
+
+    total -= (long long)(n - j) - max(a, b);
+    distinct[n - j - 1] = total;
+
+    if (p != -1)
+    {
+      nxt[p] = q;
+      lcp_next[p] = q != -1 ? min(a, b) : 0;
+    }
+    if (q != -1)
+      prv[q] = p;
+  }
+  return distinct;
+}
+
+// Answers the buffered line: each query is a prefix length
+void SuffixArrayEngine::flushLine(BufferedWriter &writer)
+{
+  if (queries.empty())
+    return;
+  const vector<long long> &distinct = prefixDistinct();
+  for (int len : queries)
+  {
+    writer.writeInt(distinct[len]);
+    writer.put('\n');
+  }
+}
+
+void SuffixArrayEngine::run(BlockReader &reader, BufferedWriter &writer)
+{
+  // Same input handling as solution_SAM.cpp, but buffered per line
+  int c;
+  bool line_started = false;
+  line.clear();
+  queries.clear();
+
+  while ((c = reader.get()) != EOF)
+  {
+    if (c == '\n' || c == '\r')
+    {
+      if (line_started)
+      {
+        flushLine(writer);
+        line.clear();
+        queries.clear();
+        line_started = false;
+      }
+    }
+    else if (c == '?')
+    {
+      queries.push_back((int)line.size());
+      line_started = true;
+    }
+    else if (c >= 'a' && c <= 'z')
+    {
+      line.push_back(c - 'a');
+      line_started = true;
+    }
+  }
+  flushLine(writer);
+}
+
+#ifndef SA_NO_MAIN
+
+int main()
+{
+  BlockReader reader;
+  BufferedWriter writer;
+  SuffixArrayEngine engine;
+  engine.run(reader, writer);
+  writer.flush();
+  return 0;
+}
+
+#endif
@@ -3,65 +3,468 @@
  * Method: Suffix Automaton (SAM)
  * Language: C++
  * runtime: 0.291s
+ *
+ * The transition store is a template policy (see "Transition Policies"):
+ *   DenseTransitions    - int[26] per node (the original layout, default),
+ *                         generation-stamped so resets cost O(1)
+ *   SmallVecTransitions - sorted inline edges, dense row only on overflow
+ *   HashTransitions     - one open-addressed table keyed by (node, char)
+ * bench/bench_transitions.cpp measures throughput and RSS of each one.
+ *
+ * Node storage lives in growable arenas (common/arena.hpp): lines are no longer
+ * capped at a fixed MAXN, and memory follows the longest line actually read.
+ *
+ * After a line is built, buildIndex() enables substring statistics
+ * (occurrences, k-th distinct substring, longest repeat). Try them with
+ *   ./a.out --query   (input format above runQueries())
+ *
+ * initCorpus() + extendGeneral() + newLine() build ONE generalized
+ * automaton over many lines instead of one per line:
+ *   ./a.out --corpus  (each '?' prints corpus-wide distinct and shared counts)
+ *
+ * extend<true>() journals every mutation and undo() pops the last journaled
+ * character, with the substring count exact after each pop:
+ *   ./a.out --edit    (as the default mode, '-' deletes the last character)
+ *
+ * The second template argument is a stats policy (common/stats.hpp). With
+ * -DTCA_STATS, every line prints its extensions, clones, redirected edges,
+ * suffix-link steps, final state count and the per-extension walk lengths
+ * on stderr; otherwise the calls compile to nothing.
  */
 
-#include <iostream>
 #include <vector>
 #include <cstring>
 #include <cstdio>
+#include <array>
+#include <string>
+#include <cstdlib>
+#include <algorithm>
+#include <stdexcept>
+#include "../common/arena.hpp"
+#include "../common/fastio.hpp"
+#include "../common/stats.hpp"
+#include "../common/engine.hpp"
 
 using namespace std;
 
-// Increased buffer size to be safe
-const int MAXN = 300005;
-const int MAX_NODES = MAXN * 2;
+const int ALPHABET = 26;
 
+// ---------------------------------------------------------------
+// Transition Policies
+// Every policy answers the same six calls:
+//   reserve(n)       - make nodes [0, n) addressable
+//   reset()          - forget everything (new string)
+//   clear(u)         - node u is new: no out-edges
+//   get(u, c)        - target of u --c--> or -1
+//   set(u, c, v)     - add / overwrite u --c--> v (v = -1: no edge)
+//   copy(dst, src)   - clone all out-edges of src into dst
+// ---------------------------------------------------------------
+
+// Original layout: 26 ints per node, plus the row's stamp (108 bytes).
+// Rows are generation-stamped: reset() and clear(u) are O(1), and a
+// stale row reads as "no edges" until its first write clears it.
+struct DenseTransitions
+{
+  struct Row
+  {
+    int stamp; // Row is valid only if stamp == generation
+    int next[ALPHABET]; // -1 indicates no edge.
+  };
+
+  Arena<Row> rows; // Zero pages, i.e. stale: generation starts at 1
+  int generation = 0;
+
+  void reserve(int n) { rows.reserve(n); }
+
+  void reset() { generation++; }
+
+  void clear(int u) { rows[u].stamp = generation - 1; }
+
+  int get(int u, int c) const
+  {
+    const Row &r = rows[u];
+    return r.stamp == generation ? r.next[c] : -1;
+  }
+
+  void set(int u, int c, int v)
+  {
+    Row &r = rows[u];
+    if (r.stamp != generation)
+    {
+      memset(r.next, -1, sizeof(r.next));
+      r.stamp = generation;
+    }
+    r.next[c] = v;
+  }
+
+  void copy(int dst, int src)
+  {
+    const Row &s = rows[src];
+    Row &d = rows[dst];
+    if (s.stamp != generation)
+    {
+      d.stamp = generation - 1;
+      return;
+    }
+    d = s;
+  }
+};
+
+// Most SAM nodes have 1-3 out-edges. Keep up to INLINE edges sorted by
+// character inside the node, and only give a node a dense 26-int row
+// (from a shared pool) when it overflows.
+struct SmallVecTransitions
+{
+  static const int INLINE = 4;
+
+  struct Row
+  {
+    unsigned char cnt;
+    unsigned char key[INLINE];
+    int val[INLINE];
+    int spill; // Index into 'overflow', or -1
+  };
+
+  Arena<Row> rows;
+  vector<array<int, ALPHABET>> overflow;
+
+  void reserve(int n) { rows.reserve(n); }
+
+  void reset() { overflow.clear(); }
+
+  void clear(int u)
+  {
+    rows[u].cnt = 0;
+    rows[u].spill = -1;
+  }
+
+  int get(int u, int c) const
+  {
+    const Row &r = rows[u];
+    if (r.spill >= 0)
+      return overflow[r.spill][c];
+    for (int i = 0; i < r.cnt && r.key[i] <= c; ++i)
+    {
+      if (r.key[i] == c)
+        return r.val[i];
+    }
+    return -1;
+  }
+
+  void set(int u, int c, int v)
+  {
+    Row &r = rows[u];
+    if (r.spill >= 0)
+    {
+      overflow[r.spill][c] = v;
+      return;
+    }
+
+    int i = 0;
+    while (i < r.cnt && r.key[i] < c)
+      i++;
+    if (i < r.cnt && r.key[i] == c)
+    {
+      r.val[i] = v;
+      return;
+    }
+
+    if (r.cnt < INLINE)
+    {
+      // Sorted insert
+      for (int j = r.cnt; j > i; --j)
+      {
+        r.key[j] = r.key[j - 1];
+        r.val[j] = r.val[j - 1];
+      }
+      r.key[i] = (unsigned char)c;
+      r.val[i] = v;
+      r.cnt++;
+      return;
+    }
+
+    // Spill: move the inline edges into a dense row
+    array<int, ALPHABET> dense;
+    dense.fill(-1);
+    for (int j = 0; j < r.cnt; ++j)
+      dense[r.key[j]] = r.val[j];
+    dense[c] = v;
+    r.spill = (int)overflow.size();
+    overflow.push_back(dense);
+  }
+
+  void copy(int dst, int src)
+  {
+    rows[dst] = rows[src];
+    if (rows[src].spill >= 0)
+    {
+      rows[dst].spill = (int)overflow.size();
+      overflow.push_back(overflow[rows[src].spill]);
+    }
+  }
+};
+
+// One open-addressed table for all edges, keyed by node * 32 + char
+// (unsigned: up to 2^27 nodes, i.e. lines of ~67 million characters;
+// reserve() throws std::length_error past that, where the keys of two
+// nodes would collide).
+// A 26-bit mask per node answers "no edge" without probing, which is the
+// common case in the while loop of extend(), and lists the edges to copy.
+struct HashTransitions
+{
+  static const int INITIAL_CAPACITY = 1 << 10; // Must match 'shift'
+  static const int MAX_NODES = 1 << 27;         // node * 32 + char fits 32 bits
+
+  struct Slot
+  {
+    unsigned key; // EMPTY = free slot
+    int val;
+  };
+  static const unsigned EMPTY = ~0u;
+
+  vector<Slot> slots;
+  int used = 0;
+  int shift = 32 - 10; // 32 - log2(capacity)
+  Arena<unsigned> mask;
+
+  void reserve(int n)
+  {
+    if (n > MAX_NODES)
+      throw length_error("HashTransitions: " + to_string(n) + " nodes requested, keys fit " + to_string(MAX_NODES));
+    mask.reserve(n);
+  }
+
+  void reset()
+  {
+    slots.assign(INITIAL_CAPACITY, Slot{EMPTY, -1});
+    shift = 32 - 10;
+    used = 0;
+  }
+
+  void clear(int u) { mask[u] = 0; }
+
+  // Fibonacci hashing: the HIGH bits of key * 2^32/phi are well mixed.
+  unsigned hashKey(unsigned key) const
+  {
+    return (key * 2654435769u) >> shift;
+  }
+
+  int find(unsigned key) const
+  {
+    unsigned m = (unsigned)slots.size() - 1;
+    unsigned pos = hashKey(key);
+    while (slots[pos].key != EMPTY && slots[pos].key != key)
+      pos = (pos + 1) & m;
+    return (int)pos;
+  }
+
+  int get(int u, int c) const
+  {
+    if (!((mask[u] >> c) & 1))
+      return -1;
+    return slots[find((unsigned)u * 32 + c)].val;
+  }
+
+  void grow()
+  {
+    vector<Slot> old;
+    old.swap(slots);
+    slots.assign(old.size() * 2, Slot{EMPTY, -1});
+    shift--;
+    for (const Slot &s : old)
+    {
+      if (s.key != EMPTY)
+        slots[find(s.key)] = s;
+    }
+  }
+
+  void set(int u, int c, int v)
+  {
+    if ((used + 1) * 2 > (int)slots.size())
+      grow();
+    unsigned key = (unsigned)u * 32 + c;
+    int pos = find(key);
+    if (slots[pos].key == EMPTY)
+    {
+      slots[pos].key = key;
+      used++;
+    }
+    slots[pos].val = v;
+    mask[u] |= 1u << c;
+  }
+
+  void copy(int dst, int src)
+  {
+    mask[dst] = 0;
+    for (unsigned m = mask[src]; m; m &= m - 1)
+    {
+      int c = __builtin_ctz(m);
+      set(dst, c, get(src, c));
+    }
+  }
+};
+
+template <class Transitions, class StatsPolicy = Stats>
 struct SAM
 {
-  int len[MAX_NODES];
-  int link[MAX_NODES];
-  // Using 2D array for transitions.
-  // -1 indicates no edge.
-  int t_next[MAX_NODES][26];
+  Arena<int> len;
+  Arena<int> link;
+  Arena<int> firstpos; // End of the first occurrence (clones inherit it)
+  Transitions t_next;
 
   int sz;
   int last;
   long long total_substrings;
 
+  // Generalized mode (initCorpus). A state's strings all occur in the
+  // same set of lines, so one counter per state is enough.
+  bool general = false;
+  int line_id = 0;             // Never reset: marks of old corpora stay stale
+  long long shared_substrings; // Distinct substrings found in 2+ lines
+  Arena<int> line_mark;        // Last line whose prefixes reached the state
+  Arena<int> line_count;       // Number of lines containing the state's strings
+
+  // Undo journal (extend<true> / undo). Every mutation of a state that
+  // existed before the extension is logged with its old value; the new
+  // states themselves are dropped by restoring sz.
+  struct JournalEntry
+  {
+    int node;
+    int c;   // Edge label, or -1 for link[node]
+    int old; // Previous target / link
+  };
+  struct JournalFrame
+  {
+    int mark; // journal.size() before the extension
+    int sz;
+    int last;
+    long long total_substrings;
+  };
+  vector<JournalEntry> journal;
+  vector<JournalFrame> frames;
+
+  // Post-build index (buildIndex). Stale after the next extend().
+  vector<int> order;       // States by increasing len
+  vector<int> occ;         // |endpos|: occurrences of each string of the state
+  vector<long long> paths; // Distinct substrings starting at the state, itself included
+  int repeat_state;        // Longest state that occurs at least twice
+
+  // extend() statistics; the driver calls stats.endCase() per line
+  enum
+  {
+    S_EXTENDS,
+    S_CLONES,
+    S_REDIRECTS,
+    S_LINK_STEPS,
+    S_STATES
+  };
+  enum
+  {
+    H_WALK // Edges added to 'cur' by one extension (suffix-link steps)
+  };
+  StatsPolicy stats{{"extends", "clones", "redirects", "link_steps", "states"}, {"walk"}};
+
+  // Nodes [0, n) become addressable; O(1) unless the arenas must grow
+  void reserve(int n)
+  {
+    len.reserve(n);
+    link.reserve(n);
+    firstpos.reserve(n);
+    t_next.reserve(n);
+  }
+
   void init()
   {
+    reserve(1);
+    t_next.reset();
+
     // Initialize the root (node 0)
     len[0] = 0;
     link[0] = -1;
+    firstpos[0] = -1;
     // We must clear the root's transitions
-    memset(t_next[0], -1, sizeof(t_next[0]));
+    t_next.clear(0);
 
     sz = 1;   // Next available node index
     last = 0; // Index of the node representing the entire string so far
     total_substrings = 0;
+    general = false;
+    journal.clear();
+    frames.clear();
   }
 
+  // Splits q (reached from p by char_idx, len[q] > len[p] + 1) and returns
+  // the clone holding the strings of q up to length len[p] + 1.
+  template <bool JOURNAL = false>
+  int split(int p, int q, int char_idx)
+  {
+    int clone = sz++;
+    len[clone] = len[p] + 1;
+    link[clone] = link[q];
+    firstpos[clone] = firstpos[q];
+    if (general)
+    {
+      // Shorter suffixes of the same strings: the same lines, so the
+      // shared count is unchanged by the split.
+      line_mark[clone] = line_mark[q];
+      line_count[clone] = line_count[q];
+    }
+
+    // Copy transitions from q to clone
+    // No need to clear clone, because copy overwrites everything
+    t_next.copy(clone, q);
+
+    int redirects = 0;
+    while (p != -1 && t_next.get(p, char_idx) == q)
+    {
+      if (JOURNAL)
+        journal.push_back({p, char_idx, q});
+      t_next.set(p, char_idx, clone);
+      p = link[p];
+      redirects++;
+    }
+    stats.add(S_CLONES);
+    stats.add(S_REDIRECTS, redirects);
+    if (JOURNAL)
+      journal.push_back({q, -1, link[q]});
+    link[q] = clone;
+    return clone;
+  }
+
+  // JOURNAL = true logs the extension so that undo() can pop it
+  template <bool JOURNAL = false>
   void extend(char c)
   {
     int char_idx = c - 'a';
 
-    // Safety check: prevent out of bounds
-    if (sz >= MAX_NODES - 2)
-      return;
+    // Room for 'cur' and a possible clone
+    reserve(sz + 2);
+
+    if (JOURNAL)
+      frames.push_back({(int)journal.size(), sz, last, total_substrings});
 
     int cur = sz++;
 
     // CRITICAL FIX: Clear the transitions for the new node 'cur'.
     // It might contain garbage from the previous test case.
+    // (O(1) for every policy: dense rows are only marked stale.)
     len[cur] = len[last] + 1;
-    memset(t_next[cur], -1, sizeof(t_next[cur]));
+    firstpos[cur] = len[cur] - 1;
+    t_next.clear(cur);
 
     int p = last;
-    while (p != -1 && t_next[p][char_idx] == -1)
+    int steps = 0;
+    while (p != -1 && t_next.get(p, char_idx) == -1)
     {
-      t_next[p][char_idx] = cur;
+      if (JOURNAL)
+        journal.push_back({p, char_idx, -1});
+      t_next.set(p, char_idx, cur);
       p = link[p];
+      steps++;
     }
+    stats.add(S_EXTENDS);
+    stats.add(S_LINK_STEPS, steps);
+    stats.sample(H_WALK, steps);
 
     if (p == -1)
     {
@@ -69,59 +472,267 @@ struct SAM
     }
     else
     {
-      int q = t_next[p][char_idx];
+      int q = t_next.get(p, char_idx);
       if (len[p] + 1 == len[q])
       {
         link[cur] = q;
       }
       else
       {
-        int clone = sz++;
-        len[clone] = len[p] + 1;
-        link[clone] = link[q];
+        link[cur] = split<JOURNAL>(p, q, char_idx);
+      }
+    }
+
+    last = cur;
+    // Count new distinct substrings
+    total_substrings += (long long)(len[cur] - len[link[cur]]);
+  }
+
+  // Pops the last journaled extension. A pop costs what its push cost:
+  // one step per log entry, i.e. O(1 + redirected edges). extend() is
+  // amortized O(1) only over pushes alone: alternating extend / undo on
+  // a character that clones and redirects O(n) edges costs O(n) per pair.
+  // Returns false if there is nothing to undo.
+  bool undo()
+  {
+    if (frames.empty())
+      return false;
+    JournalFrame f = frames.back();
+    frames.pop_back();
+
+    // Newest first: an edge redirected to the clone goes back to q, an
+    // edge added for 'cur' is removed, and link[q] skips the clone again.
+    while ((int)journal.size() > f.mark)
+    {
+      JournalEntry e = journal.back();
+      journal.pop_back();
+      if (e.c < 0)
+        link[e.node] = e.old;
+      else
+        t_next.set(e.node, e.c, e.old);
+    }
+
+    sz = f.sz; // Drops 'cur' and the clone
+    last = f.last;
+    total_substrings = f.total_substrings;
+    return true;
+  }
+
+  // ---------------------------------------------------------------
+  // Generalized SAM: one automaton over a corpus of lines
+  // ---------------------------------------------------------------
+
+  void initCorpus()
+  {
+    init();
+    general = true;
+    line_id++;
+    shared_substrings = 0;
+  }
+
+  // Next line: back to the root, the automaton is kept
+  void newLine()
+  {
+    last = 0;
+    line_id++;
+  }
+
+  void extendGeneral(char c)
+  {
+    int char_idx = c - 'a';
+    line_mark.reserve(sz + 2);
+    line_count.reserve(sz + 2);
+
+    int q = t_next.get(last, char_idx);
+    if (q == -1)
+    {
+      // New string: the ordinary extension creates 'cur' (= old sz)
+      int cur = sz;
+      line_mark[cur] = 0;
+      line_count[cur] = 0;
+      extend(c);
+    }
+    else if (len[q] == len[last] + 1)
+    {
+      // last + c already is the longest string of q: no new state
+      last = q;
+    }
+    else
+    {
+      // last + c exists inside q: it must get a state of its own,
+      // otherwise 'last' would stand for strings longer than the line
+      last = split(last, q, char_idx);
+    }
+
+    // Every suffix of the current prefix occurs in this line. The marks
+    // along the suffix links stop at the first state already marked.
+    for (int v = last; v > 0 && line_mark[v] != line_id; v = link[v])
+    {
+      line_mark[v] = line_id;
+      if (++line_count[v] == 2)
+        shared_substrings += len[v] - len[link[v]];
+    }
+  }
+
+  // ---------------------------------------------------------------
+  // Substring Statistics
+  // ---------------------------------------------------------------
+
+  // O(sz * ALPHABET). Run once the line is complete.
+  void buildIndex()
+  {
+    // 1. Counting sort of the states by len (len is at most len[last])
+    vector<int> bucket(len[last] + 1, 0);
+    for (int v = 0; v < sz; ++v)
+      bucket[len[v]]++;
+    for (int l = 1; l <= len[last]; ++l)
+      bucket[l] += bucket[l - 1];
+    order.assign(sz, 0);
+    for (int v = sz - 1; v >= 0; --v)
+      order[--bucket[len[v]]] = v;
+
+    // 2. endpos sizes. Every non-clone state is the end of one prefix
+    // (a clone has len < firstpos + 1); the suffix link of a state
+    // contains its endpos, so push counts up from the longest states.
+    occ.assign(sz, 0);
+    for (int v = 1; v < sz; ++v)
+      occ[v] = (firstpos[v] + 1 == len[v]) ? 1 : 0;
+    for (int i = sz - 1; i > 0; --i)
+      occ[link[order[i]]] += occ[order[i]];
+
+    // 3. Paths. A transition always goes to a longer state, so children
+    // are done before their parents in decreasing len order.
+    paths.assign(sz, 0);
+    for (int i = sz - 1; i >= 0; --i)
+    {
+      int v = order[i];
+      long long p = 1; // The string that stops here
+      for (int c = 0; c < ALPHABET; ++c)
+      {
+        int u = t_next.get(v, c);
+        if (u != -1)
+          p += paths[u];
+      }
+      paths[v] = p;
+    }
+    // paths[0] - 1 == total_substrings: the root's 1 is the empty string
 
-        // Copy transitions from q to clone
-        // No need to memset clone, because memcpy overwrites everything
-        memcpy(t_next[clone], t_next[q], sizeof(t_next[q]));
+    // 4. Longest repeated substring: deepest state with 2+ occurrences
+    repeat_state = 0;
+    for (int v = 1; v < sz; ++v)
+    {
+      if (occ[v] >= 2 && len[v] > len[repeat_state])
+        repeat_state = v;
+    }
+  }
+
+  // Occurrences of 'pattern' in the line. O(|pattern|).
+  int occurrences(string_view pattern) const
+  {
+    if (pattern.empty())
+      return 0;
+    int v = 0;
+    for (char ch : pattern)
+    {
+      if (ch < 'a' || ch > 'z')
+        return 0;
+      v = t_next.get(v, ch - 'a');
+      if (v == -1)
+        return 0;
+    }
+    return occ[v];
+  }
 
-        while (p != -1 && t_next[p][char_idx] == q)
+  // k-th (1-based) distinct substring in lexicographic order, or "" if
+  // k is out of range. O(|answer| * ALPHABET).
+  string kth(long long k) const
+  {
+    string out;
+    if (k < 1 || k > paths[0] - 1)
+      return out;
+
+    int v = 0;
+    while (k > 0)
+    {
+      for (int c = 0; c < ALPHABET; ++c)
+      {
+        int u = t_next.get(v, c);
+        if (u == -1)
+          continue;
+        if (k <= paths[u])
         {
-          t_next[p][char_idx] = clone;
-          p = link[p];
+          // Take the edge; the string ending here is the first below u
+          out.push_back(char('a' + c));
+          k--;
+          v = u;
+          break;
         }
-        link[q] = clone;
-        link[cur] = clone;
+        k -= paths[u];
       }
     }
+    return out;
+  }
 
-    last = cur;
-    // Count new distinct substrings
-    total_substrings += (long long)(len[cur] - len[link[cur]]);
+  // Length of the longest substring occurring at least twice (0 if none).
+  // 'end' gets the index of its last character in its first occurrence.
+  int longestRepeat(int &end) const
+  {
+    end = firstpos[repeat_state];
+    return len[repeat_state];
   }
-} sam;
+};
 
-int main()
+// ---------------------------------------------------------------
+// Engine
+// The automaton lives in a reentrant engine (common/engine.hpp): run()
+// is the judge's mode, the other modes share its automaton.
+// Block I/O (common/fastio.hpp): input is mmap()ed or read in 1 MB
+// blocks and answers are formatted into a 64 KB buffer, so the driver
+// loop makes no stdio call per character and SAM::extend is the only
+// hot code.
+// ---------------------------------------------------------------
+struct SubstringsEngine : ReentrantEngine<SubstringsEngine>
+{
+  SAM<DenseTransitions> sam;
+
+  void endLineStats();
+  void run(BlockReader &reader, BufferedWriter &writer);
+  void runQueries(BlockReader &reader, BufferedWriter &writer);
+  void runCorpus(BlockReader &reader, BufferedWriter &writer);
+  void runEdit(BlockReader &reader, BufferedWriter &writer);
+};
+
+// One stats case per line (nothing unless built with -DTCA_STATS)
+void SubstringsEngine::endLineStats()
+{
+  sam.stats.add(sam.S_STATES, sam.sz);
+  sam.stats.endCase();
+}
+
+void SubstringsEngine::run(BlockReader &reader, BufferedWriter &writer)
 {
   // Robust Input Parsing
-  char c;
+  int c;
   bool line_started = false;
 
   sam.init();
 
-  while ((c = getchar()) != EOF)
+  while ((c = reader.get()) != EOF)
   {
     if (c == '\n' || c == '\r')
     {
       // Newline or Carriage Return detected
       if (line_started)
       {
+        endLineStats();
         sam.init(); // Reset for the next string
         line_started = false;
       }
     }
     else if (c == '?')
     {
-      printf("%lld\n", sam.total_substrings);
+      writer.writeInt(sam.total_substrings);
+      writer.put('\n');
       line_started = true;
     }
     else if (c >= 'a' && c <= 'z')
@@ -131,5 +742,180 @@ int main()
     }
     // Ignore other characters
   }
+  if (line_started)
+    endLineStats();
+}
+
+// Query mode. Input, repeated until EOF:
+//   <text>
+//   <q>
+//   q lines of: "count <pattern>" | "kth <k>" | "repeat"
+// Output, one line per query: the count; the k-th substring ("-" if k is
+// out of range); the longest repeat as "<length> <substring>" ("0" if none).
+void SubstringsEngine::runQueries(BlockReader &reader, BufferedWriter &writer)
+{
+  string text;
+  string_view word;
+  int q;
+  // 'word' points into the reader's buffer: the text is copied, since the
+  // repeat query prints a piece of it after later reads.
+  while (reader.readWord(word) && reader.readInt(q))
+  {
+    text.assign(word.data(), word.size());
+    sam.init();
+    for (char c : text)
+    {
+      if (c >= 'a' && c <= 'z')
+        sam.extend(c);
+    }
+    sam.buildIndex();
+
+    while (q--)
+    {
+      string_view op;
+      reader.readWord(op);
+      if (op == "count")
+      {
+        string_view pattern;
+        reader.readWord(pattern);
+        writer.writeInt(sam.occurrences(pattern));
+        writer.put('\n');
+      }
+      else if (op == "kth")
+      {
+        long long k = 0;
+        reader.readInt(k);
+        string sub = sam.kth(k);
+        writer.write(sub.empty() ? "-" : sub);
+        writer.put('\n');
+      }
+      else if (op == "repeat")
+      {
+        int end;
+        int length = sam.longestRepeat(end);
+        if (length == 0)
+        {
+          writer.write("0\n");
+        }
+        else
+        {
+          writer.writeInt(length);
+          writer.put(' ');
+          writer.write(string_view(text).substr(end - length + 1, length));
+          writer.put('\n');
+        }
+      }
+    }
+  }
+}
+
+// Corpus mode: the same input as run(), but all lines feed one
+// generalized automaton. Each '?' prints "<distinct> <shared>": distinct
+// substrings over all lines so far, and how many of them occur in 2+ lines.
+void SubstringsEngine::runCorpus(BlockReader &reader, BufferedWriter &writer)
+{
+  int c;
+  bool line_started = false;
+
+  sam.initCorpus();
+
+  while ((c = reader.get()) != EOF)
+  {
+    if (c == '\n' || c == '\r')
+    {
+      if (line_started)
+      {
+        sam.newLine();
+        line_started = false;
+      }
+    }
+    else if (c == '?')
+    {
+      writer.writeInt(sam.total_substrings);
+      writer.put(' ');
+      writer.writeInt(sam.shared_substrings);
+      writer.put('\n');
+      line_started = true;
+    }
+    else if (c >= 'a' && c <= 'z')
+    {
+      sam.extendGeneral(c);
+      line_started = true;
+    }
+  }
+}
+
+// Edit mode: the same input as run(), plus '-', which deletes the last
+// character of the current line (nothing if it is empty).
+void SubstringsEngine::runEdit(BlockReader &reader, BufferedWriter &writer)
+{
+  int c;
+  bool line_started = false;
+
+  sam.init();
+
+  while ((c = reader.get()) != EOF)
+  {
+    if (c == '\n' || c == '\r')
+    {
+      if (line_started)
+      {
+        sam.init();
+        line_started = false;
+      }
+    }
+    else if (c == '?')
+    {
+      writer.writeInt(sam.total_substrings);
+      writer.put('\n');
+      line_started = true;
+    }
+    else if (c == '-')
+    {
+      sam.undo();
+      line_started = true;
+    }
+    else if (c >= 'a' && c <= 'z')
+    {
+      sam.extend<true>(c);
+      line_started = true;
+    }
+  }
+}
+
+#ifndef SAM_NO_MAIN
+
+int main(int argc, char **argv)
+{
+  BlockReader reader(BlockReader::ASYNC);
+  BufferedWriter writer;
+  SubstringsEngine engine;
+  try
+  {
+    if (argc > 1 && string(argv[1]) == "--corpus")
+    {
+      engine.runCorpus(reader, writer);
+    }
+    else if (argc > 1 && string(argv[1]) == "--edit")
+    {
+      engine.runEdit(reader, writer);
+    }
+    else if (argc > 1 && string(argv[1]) == "--query")
+    {
+      engine.runQueries(reader, writer);
+    }
+    else
+    {
+      engine.run(reader, writer);
+    }
+  }
+  catch (const exception &e) // Out of memory (Arena), too many nodes (HashTransitions)
+  {
+    fprintf(stderr, "%s\n", e.what());
+    return 1;
+  }
+  writer.flush();
   return 0;
 }
+
+#endif
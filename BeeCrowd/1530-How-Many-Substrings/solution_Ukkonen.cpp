@@ -1,51 +1,91 @@
 /**
  * Problem: Beecrowd 1530 - How Many Substrings?
  * Language: C++
- * Optimization: Static Arrays, Reset Optimization, Ukkonen's Algorithm
+ * Optimization: Growable Arenas (common/arena.hpp), Generation-Stamped Lazy Reset, Ukkonen's Algorithm,
+ *               Block I/O (common/fastio.hpp)
  * runtime: 0.214s
  */
-#include <iostream>
 #include <vector>
-#include <string>
-#include <cstring>
+#include <string_view>
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <new>
+#include "../common/arena.hpp"
+#include "../common/fastio.hpp"
+#include "../common/engine.hpp"
 
 using namespace std;
 
 const int INF = 1e9;
-const int MAXN = 200005;        // Max string length
-const int MAX_NODES = MAXN * 2; // Max nodes in suffix tree
-
-// Tree Structure (Static Arrays)
-int t_start[MAX_NODES];
-int t_len[MAX_NODES];      // Length of edge
-int t_link[MAX_NODES];     // Suffix Link
-int t_depth[MAX_NODES];    // String depth (cumulative length from root)
-int t_next[MAX_NODES][26]; // Children edges
-
-// Global variables for the current tree state
-int nodes_count;
-int active_node;
-int active_len;
-int active_edge_char_idx; // Index in S[]
-int rem;                  // Remainder
-long long total_substrings;
-
-// Input String Buffer
-int S[MAXN];
-int s_len;
-
-void reset_tree()
+
+// Reentrant engine (common/engine.hpp): the tree and its arenas.
+// Fast I/O: each line is read as a view into the input buffer
+struct SuffixTreeEngine : ReentrantEngine<SuffixTreeEngine>
 {
-  // Only clear the nodes we used in the previous iteration
-  // Root is always 1
-  for (int i = 0; i <= nodes_count; i++)
+  // Tree Structure (Growable Arenas)
+  Arena<int> t_start;
+  Arena<int> t_len;               // Length of edge
+  Arena<int> t_link;              // Suffix Link
+  Arena<int> t_depth;             // String depth (cumulative length from root)
+  Arena<array<int, 26>> t_next;   // Children edges (valid only if t_stamp == generation)
+  Arena<int> t_stamp;             // Generation in which the row of t_next was cleared
+  int generation = 0;
+
+  // Current tree state
+  int nodes_count;
+  int active_node;
+  int active_len;
+  int active_edge_char_idx; // Index in S[]
+  int rem;                  // Remainder
+  long long total_substrings;
+
+  // Input String Buffer
+  Arena<int> S;
+  int s_len;
+
+  // A string of length n has at most 2n nodes (root is 1)
+  void reserve_nodes(int n)
+  {
+    t_start.reserve(n);
+    t_len.reserve(n);
+    t_link.reserve(n);
+    t_depth.reserve(n);
+    t_next.reserve(n);
+    t_stamp.reserve(n); // Zero, i.e. stale: generation starts at 1
+  }
+
+  // Lazy children access.
+  // A row whose stamp is not the current generation is stale and reads as
+  // "no children". It is only cleared on its first write, so leaves (which
+  // never get children) never pay for a memset.
+  int get_child(int node, int c)
+  {
+    return t_stamp[node] == generation ? t_next[node][c] : 0;
+  }
+
+  void set_child(int node, int c, int child)
   {
-    // No need to clear start/len/depth/link if we overwrite them,
-    // but t_next MUST be cleared because we check for 0 (null).
-    // Clearing 26 integers is fast.
-    memset(t_next[i], 0, sizeof(t_next[i]));
+    if (t_stamp[node] != generation)
+    {
+      t_next[node].fill(0);
+      t_stamp[node] = generation;
+    }
+    t_next[node][c] = child;
   }
 
+  void reset_tree();
+  void run(BlockReader &reader, BufferedWriter &writer);
+};
+
+void SuffixTreeEngine::reset_tree()
+{
+  // O(1): bumping the generation makes every row stale at once,
+  // whatever the size of the previous tree.
+  generation++;
+
+  reserve_nodes(2);
   nodes_count = 1;
   t_len[1] = 0; // Root len
   t_link[1] = 0;
@@ -59,26 +99,27 @@ void reset_tree()
   s_len = 0;
 }
 
-void solve()
+void SuffixTreeEngine::run(BlockReader &reader, BufferedWriter &writer)
 {
-  string line;
-  while (cin >> line)
+  string_view line;
+  while (reader.readWord(line))
   {
     reset_tree();
 
-    string output_buffer = "";
-
     for (char c : line)
     {
       if (c == '?')
       {
-        cout << total_substrings << "\n";
+        writer.writeInt(total_substrings);
+        writer.put('\n');
         continue;
       }
 
       // Add character to string
       int charVal = c - 'a';
+      S.reserve(s_len + 1);
       S[s_len++] = charVal;
+      reserve_nodes(2 * s_len + 2);
       rem++;
 
       int last_new_node = 0;
@@ -91,7 +132,7 @@ void solve()
         }
 
         int edge_char = S[active_edge_char_idx];
-        int child = t_next[active_node][edge_char];
+        int child = get_child(active_node, edge_char);
 
         if (child == 0)
         {
@@ -104,8 +145,8 @@ void solve()
           t_link[leaf] = 1;
           t_depth[leaf] = t_depth[active_node] + t_len[leaf]; // Virtual depth
 
-          // t_next is already 0 due to reset logic
-          t_next[active_node][edge_char] = leaf;
+          // The leaf's own row is stale, i.e. empty
+          set_child(active_node, edge_char, leaf);
 
           if (last_new_node != 0)
           {
@@ -155,7 +196,7 @@ void solve()
           t_depth[split] = t_depth[active_node] + active_len;
 
           // Update parent to point to split
-          t_next[active_node][edge_char] = split;
+          set_child(active_node, edge_char, split);
 
           nodes_count++;
           int leaf = nodes_count;
@@ -169,8 +210,8 @@ void solve()
             t_len[child] -= active_len;
 
           // Connect split
-          t_next[split][charVal] = leaf;
-          t_next[split][existing_char] = child;
+          set_child(split, charVal, leaf);
+          set_child(split, existing_char, child);
 
           if (last_new_node != 0)
           {
@@ -199,10 +240,24 @@ void solve()
   }
 }
 
+#ifndef UKKONEN_NO_MAIN
+
 int main()
 {
-  ios_base::sync_with_stdio(false);
-  cin.tie(NULL);
-  solve();
+  BlockReader reader;
+  BufferedWriter writer;
+  SuffixTreeEngine engine;
+  try
+  {
+    engine.run(reader, writer);
+  }
+  catch (const bad_alloc &e) // The arenas ran out of memory
+  {
+    fprintf(stderr, "%s\n", e.what());
+    return 1;
+  }
+  writer.flush();
   return 0;
 }
+
+#endif
@@ -0,0 +1,288 @@
+/**
+ * Batch runner: many inputs of mixed problems in one process.
+ *
+ * Usage: batch_runner [--threads N] [--repeat R] [--out DIR] <dir|file.in> ...
+ * Loads every <format>-<class>.in (tools/gen_inputs.py names them so) into
+ * memory, then answers each one R times on a pool of N threads (default:
+ * the number of CPUs). The format picks the engine:
+ *   1023 1034 1053 1058 1141 1231 1231_kdict 1324 1324_nbody 1346 1530
+ * Other formats are skipped.
+ *
+ * Each solution is a reentrant engine (common/engine.hpp). Every thread
+ * builds at most one engine per problem, on its first job of that
+ * problem, and reuses it for the following ones: tries, memo tables, DP
+ * buffers and the automaton keep their memory between jobs, and no job
+ * pays for a process start.
+ *
+ * Every answer to the same input must be identical, whichever thread and
+ * engine instance produced it; otherwise the runner reports a mismatch
+ * and exits with 1. --out DIR writes DIR/<name>.out (compare them with
+ * the output of the single-problem binaries).
+ *
+ * Prints one line per input (jobs, MB, best and mean ms per job) and the
+ * totals: wall time, jobs/s, MB/s and the number of engines built.
+ *
+ * The engines come from lib/all_engines.hpp.
+ */
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <functional>
+#include <dirent.h>
+#include "../lib/all_engines.hpp"
+
+using namespace std;
+
+// ---------------------------------------------------------------
+// Engines
+// One Workspace per thread: the engines it has built so far
+// ---------------------------------------------------------------
+struct Workspace
+{
+  unique_ptr<AnyEngine> engines[ENGINE_COUNT];
+  int built = 0;
+
+  // The engine of ENGINE_FORMATS[format], built on first use
+  AnyEngine &get(int format)
+  {
+    if (!engines[format])
+    {
+      engines[format].reset(ENGINE_FORMATS[format].make());
+      built++;
+    }
+    return *engines[format];
+  }
+};
+
+// ---------------------------------------------------------------
+// Inputs and jobs
+// ---------------------------------------------------------------
+struct Input
+{
+  string name; // <format>-<class>
+  int format;  // Index in ENGINE_FORMATS
+  string data;
+
+  // Filled by the workers
+  atomic<bool> answered{false};
+  size_t first_hash = 0; // Hash of the first answer (set once)
+  atomic<int> mismatches{0};
+  atomic<long long> best_ns{LLONG_MAX};
+  atomic<long long> total_ns{0};
+};
+
+bool readFile(const string &path, string &data)
+{
+  FILE *f = fopen(path.c_str(), "rb");
+  if (!f)
+    return false;
+  char buf[1 << 16];
+  size_t n;
+  data.clear();
+  while ((n = fread(buf, 1, sizeof buf, f)) > 0)
+    data.append(buf, n);
+  fclose(f);
+  return true;
+}
+
+// A directory gives its *.in files (sorted), a file itself
+vector<string> listInputs(const string &path)
+{
+  vector<string> files;
+  DIR *dir = opendir(path.c_str());
+  if (!dir)
+  {
+    files.push_back(path);
+    return files;
+  }
+  while (dirent *e = readdir(dir))
+  {
+    string name = e->d_name;
+    if (name.size() > 3 && name.compare(name.size() - 3, 3, ".in") == 0)
+      files.push_back(path + "/" + name);
+  }
+  closedir(dir);
+  sort(files.begin(), files.end());
+  return files;
+}
+
+// "dir/1058-large.in" -> "1058-large"
+string baseName(const string &path)
+{
+  size_t slash = path.rfind('/');
+  string name = slash == string::npos ? path : path.substr(slash + 1);
+  if (name.size() > 3 && name.compare(name.size() - 3, 3, ".in") == 0)
+    name.resize(name.size() - 3);
+  return name;
+}
+
+void atomicMin(atomic<long long> &a, long long v)
+{
+  long long cur = a.load();
+  while (v < cur && !a.compare_exchange_weak(cur, v))
+  {
+  }
+}
+
+// ---------------------------------------------------------------
+// Thread pool: the workers take jobs (input, repetition) in order from
+// one atomic counter, so a slow input never holds back the others.
+// ---------------------------------------------------------------
+struct Pool
+{
+  vector<unique_ptr<Input>> &inputs;
+  int repeat;
+  string out_dir;
+  atomic<size_t> next{0};
+  atomic<int> engines_built{0};
+  mutex first_lock; // Guards first_hash of the inputs
+
+  Pool(vector<unique_ptr<Input>> &in, int r, const string &out) : inputs(in), repeat(r), out_dir(out) {}
+
+  void worker()
+  {
+    Workspace ws;
+    size_t jobs = inputs.size() * repeat;
+    for (size_t j; (j = next.fetch_add(1)) < jobs;)
+    {
+      // Job j: repetition j / n of input j % n, so all inputs start early
+      Input &in = *inputs[j % inputs.size()];
+
+      auto t0 = chrono::steady_clock::now();
+      string output = ws.get(in.format).solve(in.data);
+      long long ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - t0).count();
+
+      atomicMin(in.best_ns, ns);
+      in.total_ns += ns;
+      check(in, output);
+    }
+    engines_built += ws.built;
+  }
+
+  void check(Input &in, const string &output)
+  {
+    size_t h = hash<string>()(output);
+    bool first = false;
+    {
+      lock_guard<mutex> lock(first_lock);
+      if (!in.answered)
+      {
+        in.first_hash = h;
+        in.answered = true;
+        first = true;
+      }
+    }
+    if (!first && h != in.first_hash)
+      in.mismatches++;
+    if (first && !out_dir.empty())
+    {
+      string path = out_dir + "/" + in.name + ".out";
+      FILE *f = fopen(path.c_str(), "wb");
+      if (f)
+      {
+        fwrite(output.data(), 1, output.size(), f);
+        fclose(f);
+      }
+      else
+      {
+        fprintf(stderr, "cannot write %s\n", path.c_str());
+      }
+    }
+  }
+};
+
+int main(int argc, char **argv)
+{
+  int threads = (int)thread::hardware_concurrency();
+  int repeat = 1;
+  string out_dir;
+  vector<string> paths;
+  for (int i = 1; i < argc; ++i)
+  {
+    string arg = argv[i];
+    if (arg == "--threads" && i + 1 < argc)
+      threads = atoi(argv[++i]);
+    else if (arg == "--repeat" && i + 1 < argc)
+      repeat = atoi(argv[++i]);
+    else if (arg == "--out" && i + 1 < argc)
+      out_dir = argv[++i];
+    else
+      paths.push_back(arg);
+  }
+  if (paths.empty() || threads < 1 || repeat < 1)
+  {
+    fprintf(stderr, "usage: %s [--threads N] [--repeat R] [--out DIR] <dir|file.in> ...\n", argv[0]);
+    return 2;
+  }
+
+  // 1. Load the inputs (not timed)
+  vector<unique_ptr<Input>> inputs;
+  double total_mb = 0;
+  for (const string &path : paths)
+  {
+    for (const string &file : listInputs(path))
+    {
+      string name = baseName(file);
+      int format = findEngineFormat(string_view(name).substr(0, name.find('-')));
+      if (format < 0)
+      {
+        printf("skipping %s: no engine for its format\n", name.c_str());
+        continue;
+      }
+      unique_ptr<Input> in(new Input());
+      in->name = name;
+      in->format = format;
+      if (!readFile(file, in->data))
+      {
+        fprintf(stderr, "cannot read %s\n", file.c_str());
+        return 2;
+      }
+      total_mb += in->data.size() / 1e6;
+      inputs.push_back(move(in));
+    }
+  }
+  if (inputs.empty())
+  {
+    fprintf(stderr, "no input with a known format\n");
+    return 2;
+  }
+
+  // 2. Run every (input, repetition) on the pool
+  Pool pool(inputs, repeat, out_dir);
+  auto t0 = chrono::steady_clock::now();
+  vector<thread> workers;
+  for (int t = 0; t < threads; ++t)
+    workers.emplace_back([&pool] { pool.worker(); });
+  for (thread &w : workers)
+    w.join();
+  double wall = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+
+  // 3. Report
+  bool failed = false;
+  printf("%-20s %6s %10s %10s %10s\n", "input", "jobs", "MB", "best ms", "mean ms");
+  for (auto &in : inputs)
+  {
+    printf("%-20s %6d %10.2f %10.3f %10.3f", in->name.c_str(), repeat, in->data.size() / 1e6,
+           in->best_ns / 1e6, in->total_ns / 1e6 / repeat);
+    if (in->mismatches)
+    {
+      printf("  MISMATCH (%d answers differ)", (int)in->mismatches);
+      failed = true;
+    }
+    printf("\n");
+  }
+  size_t jobs = inputs.size() * repeat;
+  printf("%zu jobs on %d threads: %.3f s, %.1f jobs/s, %.1f MB/s, %d engines built\n",
+         jobs, threads, wall, jobs / wall, total_mb * repeat / wall, (int)pool.engines_built);
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,128 @@
+/**
+ * Growable node storage for the 1530 engines (SAM, Ukkonen).
+ * Language: C++17 (header-only)
+ *
+ * Arena<T>
+ *   - A range of address space is reserved up front (PROT_NONE: no
+ *     memory behind it) and committed in doubling steps with mprotect().
+ *     Within that range elements never move, and indexing is a plain
+ *     base[i].
+ *   - Past the range (only under a tight ulimit -v, or beyond 2^28
+ *     elements) the arena re-reserves: it drops the uncommitted tail and
+ *     grows the committed part with mremap(), which may move it. Indices
+ *     stay valid; references and pointers do not survive a reserve() that
+ *     grows.
+ *   - Committed pages are zero and only count towards RSS once touched.
+ *   - reserve(n)  makes indices [0, n) addressable. If the kernel refuses
+ *     the memory or the address space it throws std::bad_alloc; it never
+ *     ends the process.
+ */
+
+#ifndef BEECROWD_ARENA_HPP
+#define BEECROWD_ARENA_HPP
+
+#include <algorithm>
+#include <climits>
+#include <new>
+#include <sys/mman.h>
+#include <sys/resource.h>
+
+template <class T>
+struct Arena
+{
+  static const int FIRST_COMMIT = 1 << 12;
+
+  T *base = nullptr;
+  int capacity = 0; // Committed elements
+  int limit = 0;    // Reserved elements (== capacity once re-reserved)
+
+  Arena()
+  {
+    // Room for 2^28 elements, but at most 1/16 of a capped address space
+    // (ulimit -v), so that the heap and the other arenas still fit. This
+    // is only where growth stops being free: past it, grow() re-reserves.
+    size_t want = size_t(1) << 28;
+    struct rlimit rl;
+    if (getrlimit(RLIMIT_AS, &rl) == 0 && rl.rlim_cur != RLIM_INFINITY)
+      want = std::min(want, (size_t)rl.rlim_cur / 16 / sizeof(T));
+    for (; want >= (size_t)FIRST_COMMIT; want /= 2)
+    {
+      void *p = mmap(nullptr, want * sizeof(T), PROT_NONE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+      if (p != MAP_FAILED)
+      {
+        base = static_cast<T *>(p);
+        limit = (int)want;
+        return;
+      }
+    }
+  }
+  Arena(const Arena &) = delete;
+  Arena &operator=(const Arena &) = delete;
+  ~Arena()
+  {
+    if (base)
+      munmap(base, (size_t)limit * sizeof(T));
+  }
+
+  // Makes indices [0, n) addressable
+  void reserve(int n)
+  {
+    if (n > capacity)
+      grow(n);
+  }
+
+  __attribute__((noinline)) void grow(int n)
+  {
+    long long want = capacity > FIRST_COMMIT ? capacity : FIRST_COMMIT;
+    while (want < n)
+      want *= 2;
+    if (n > limit)
+    {
+      reReserve((int)std::min(want, (long long)INT_MAX));
+      return;
+    }
+    int next = (int)std::min(want, (long long)limit);
+    // Out of memory (or over a mapping limit): the pages stay PROT_NONE,
+    // and 'capacity' must not claim them
+    if (mprotect(base, (size_t)next * sizeof(T), PROT_READ | PROT_WRITE) != 0)
+      throw std::bad_alloc();
+    capacity = next;
+  }
+
+  // Past the reserved range: from now on the mapping is exactly the
+  // committed elements, and each growth is one mremap(). The kernel moves
+  // the page tables, not the data, and the new pages are zero.
+  void reReserve(int next)
+  {
+    size_t bytes = (size_t)next * sizeof(T);
+    void *p;
+    if (capacity == 0)
+    {
+      if (base)
+        munmap(base, (size_t)limit * sizeof(T));
+      base = nullptr;
+      limit = 0;
+      p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    }
+    else
+    {
+      // mremap() takes one mapping: drop the PROT_NONE tail first. The
+      // committed size is a page multiple whenever a tail is left.
+      if (limit > capacity)
+        munmap(base + capacity, (size_t)(limit - capacity) * sizeof(T));
+      limit = capacity;
+      p = mremap(base, (size_t)capacity * sizeof(T), bytes, MREMAP_MAYMOVE);
+    }
+    // On failure the committed elements are untouched
+    if (p == MAP_FAILED)
+      throw std::bad_alloc();
+    base = static_cast<T *>(p);
+    capacity = limit = next;
+  }
+
+  T &operator[](int i) { return base[i]; }
+  const T &operator[](int i) const { return base[i]; }
+};
+
+#endif
@@ -0,0 +1,43 @@
+/**
+ * Reentrant engines: the solutions as classes instead of globals.
+ * Language: C++17 (header-only)
+ *
+ * Each solution keeps its whole state (tries, memo tables, DP buffers,
+ * the automaton) in one engine class and answers an input with
+ *   void run(BlockReader &reader, BufferedWriter &writer);
+ * on the judge's format. Deriving from ReentrantEngine<E> adds
+ *   std::string solve(std::string_view input);
+ * which runs it on an input in memory and returns the output.
+ *
+ * - Different instances share nothing, so they can run on several
+ *   threads at once (batch/batch_runner.cpp keeps one per thread).
+ * - One instance can answer any number of inputs in a row: every run()
+ *   starts from its own reset, and the buffers it grew are kept.
+ * - main() is the judge driver: stdin reader, stdout writer, one run().
+ *   Defining <P>_NO_MAIN (P1023_NO_MAIN, ..., SAM_NO_MAIN) leaves it out,
+ *   so other programs can include the solution file.
+ */
+
+#ifndef BEECROWD_ENGINE_HPP
+#define BEECROWD_ENGINE_HPP
+
+#include <string>
+#include <string_view>
+#include "fastio.hpp"
+
+template <class Engine>
+struct ReentrantEngine
+{
+  std::string solve(std::string_view input)
+  {
+    std::string output;
+    BlockReader reader(input);
+    {
+      BufferedWriter writer(output);
+      static_cast<Engine *>(this)->run(reader, writer);
+    } // The writer flushes into 'output' here
+    return output;
+  }
+};
+
+#endif // BEECROWD_ENGINE_HPP
@@ -0,0 +1,508 @@
+/**
+ * Shared fast I/O for the C++ solutions.
+ * Language: C++17 (header-only)
+ *
+ * BlockReader
+ *   - stdin that is a regular file (./a.out < input) is mmap()ed whole;
+ *     pipes and terminals are read in 1 MB fread() blocks.
+ *   - get()        next byte or EOF (the per-character drivers)
+ *   - readWord(w)  next whitespace-separated token as a string_view
+ *   - readInt(x)   next token as a signed/unsigned integer
+ *   A string_view points into the reader's buffer and stays valid until
+ *   the next read call. Tokens that straddle two blocks are moved to the
+ *   front of the buffer, so a token is always contiguous.
+ *   BlockReader(input) reads a string_view in memory instead of stdin
+ *   (engine.hpp); its tokens point into that input.
+ *   BlockReader(BlockReader::ASYNC) reads a pipe on a second thread, one
+ *   block ahead of the parser (AsyncBlocks below), so the producer is
+ *   not stalled while the solver parses. A regular file is still mapped:
+ *   MADV_SEQUENTIAL readahead already reads it ahead, without the copy.
+ *   TCA_READER=sync|async|thread overrides the mode; 'thread' uses the
+ *   reader thread for regular files too (to compare with the mapping).
+ *
+ * BufferedWriter
+ *   - put(c), write(s), writeInt(v), writeFixed(v, digits)
+ *   - 64 KB buffer, one fwrite() per buffer; flushed by flush() and at exit.
+ *   writeFixed prints the same text as printf("%.*f") / cout << fixed.
+ *   BufferedWriter(out) appends to the string 'out' instead of stdout.
+ *
+ * perf.hpp: the mmap / fread / fwrite calls run inside a PerfIoScope, so
+ * with TCA_PERF_OUT set the counters split I/O from the solve phase.
+ *
+ * Each solution's main() declares its own `BlockReader reader; BufferedWriter
+ * writer;` and hands them to its engine (engine.hpp).
+ * The judge takes a single file: paste this header in place of its #include.
+ */
+
+#ifndef BEECROWD_FASTIO_HPP
+#define BEECROWD_FASTIO_HPP
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "perf.hpp"
+
+// Two block buffers and the thread that fills them (BlockReader::ASYNC).
+// A slot belongs to one side at a time and is handed over through its
+// state alone: EMPTY, the reader thread fills it; FULL, the parser reads
+// it. A side waits on the futex of the state only when it is ahead.
+struct AsyncBlocks
+{
+  static const size_t BLOCK = 1 << 20;
+  static const size_t HEAD = 1 << 16; // Room for a straddling token, in front of the data
+  enum State : int
+  {
+    EMPTY,
+    FULL
+  };
+
+  struct Slot
+  {
+    char *mem = nullptr; // HEAD bytes, then up to BLOCK bytes of input
+    size_t len = 0;
+    bool last = false; // End of input after this slot
+    std::atomic<int> state{EMPTY};
+  };
+
+  Slot slot[2];
+  int next = 0;  // Slot the parser takes next
+  int held = -1; // Slot the parser reads now (-1: none, or the bytes are in BlockReader::buf)
+  std::atomic<bool> stop{false};
+  std::thread thread;
+
+  AsyncBlocks()
+  {
+    for (Slot &s : slot)
+      s.mem = static_cast<char *>(malloc(HEAD + BLOCK));
+    posix_fadvise(0, 0, 0, POSIX_FADV_SEQUENTIAL);
+    thread = std::thread([this]
+                         { fill(); });
+  }
+  AsyncBlocks(const AsyncBlocks &) = delete;
+  AsyncBlocks &operator=(const AsyncBlocks &) = delete;
+  ~AsyncBlocks()
+  {
+    // The parser may stop early: hand both slots back so the thread sees 'stop'
+    stop.store(true, std::memory_order_relaxed);
+    publish(slot[0].state, EMPTY);
+    publish(slot[1].state, EMPTY);
+    thread.join();
+    for (Slot &s : slot)
+      free(s.mem);
+  }
+
+  static void wait(std::atomic<int> &state, int want)
+  {
+    for (int spin = 0; spin < 64; spin++)
+    {
+      if (state.load(std::memory_order_acquire) == want)
+        return;
+#if defined(__x86_64__) || defined(__i386__)
+      __builtin_ia32_pause();
+#endif
+    }
+    int now;
+    while ((now = state.load(std::memory_order_acquire)) != want)
+      syscall(SYS_futex, reinterpret_cast<int *>(&state), FUTEX_WAIT_PRIVATE, now, nullptr, nullptr, 0);
+  }
+
+  static void publish(std::atomic<int> &state, int value)
+  {
+    state.store(value, std::memory_order_release);
+    syscall(SYS_futex, reinterpret_cast<int *>(&state), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+  }
+
+  // Reader thread: fills the slots in turn until end of input
+  void fill()
+  {
+    for (int i = 0;; i ^= 1)
+    {
+      Slot &s = slot[i];
+      wait(s.state, EMPTY);
+      if (stop.load(std::memory_order_relaxed))
+        return;
+      char *data = s.mem + HEAD;
+      size_t got = 0;
+      while (got < BLOCK)
+      {
+        ssize_t n = read(0, data + got, BLOCK - got);
+        if (n > 0)
+          got += n;
+        else if (n == 0 || errno != EINTR)
+          break;
+      }
+      s.len = got;
+      s.last = got < BLOCK;
+      publish(s.state, FULL);
+      if (s.last)
+        return;
+    }
+  }
+
+  void release(int i)
+  {
+    if (i >= 0)
+      publish(slot[i].state, EMPTY);
+  }
+};
+
+struct BlockReader
+{
+  static const size_t BLOCK = 1 << 20;
+  enum Mode
+  {
+    SYNC,  // mmap a regular file, else fread in the parser's thread
+    ASYNC, // mmap a regular file, else read() one block ahead on a second thread
+    THREAD // read() one block ahead on a second thread, even a regular file
+  };
+
+  const char *p = nullptr;   // Next unread byte
+  const char *end = nullptr; // End of the bytes available now
+  char *buf = nullptr;       // Block buffer (unused when mapped)
+  size_t cap = 0;
+  void *map = nullptr;
+  size_t map_len = 0;
+  bool started = false;
+  bool done = false; // Nothing left behind 'end'
+  Mode mode = SYNC;
+  AsyncBlocks *async = nullptr;
+
+  BlockReader() = default;
+  explicit BlockReader(Mode m) : mode(m) {}
+  // In-memory input: nothing to map or read, the whole input is available
+  explicit BlockReader(std::string_view input)
+      : p(input.data()), end(input.data() + input.size()), started(true), done(true)
+  {
+  }
+  BlockReader(const BlockReader &) = delete;
+  BlockReader &operator=(const BlockReader &) = delete;
+  ~BlockReader()
+  {
+    delete async;
+    if (map)
+      munmap(map, map_len);
+    free(buf);
+  }
+
+  // Next byte, or EOF
+  inline int get()
+  {
+    if (p == end)
+    {
+      const char *from = p;
+      if (!refill(from))
+        return EOF;
+    }
+    return (unsigned char)*p++;
+  }
+
+  // Skips whitespace; false at end of input
+  inline bool skipSpace()
+  {
+    while (true)
+    {
+      while (p < end && (unsigned char)*p <= ' ')
+        p++;
+      if (p < end)
+        return true;
+      const char *from = p;
+      if (!refill(from))
+        return false;
+    }
+  }
+
+  inline bool readWord(std::string_view &w)
+  {
+    if (!skipSpace())
+      return false;
+    const char *from = p;
+    while (true)
+    {
+      while (p < end && (unsigned char)*p > ' ')
+        p++;
+      if (p < end || !refill(from))
+        break;
+    }
+    w = std::string_view(from, p - from);
+    return true;
+  }
+
+  // Optional sign, then digits. Like cin >> x, false at end of input.
+  template <class T>
+  inline bool readInt(T &x)
+  {
+    std::string_view w;
+    if (!readWord(w))
+      return false;
+    const char *s = w.data(), *e = s + w.size();
+    bool neg = false;
+    if (s < e && (*s == '-' || *s == '+'))
+      neg = *s++ == '-';
+    typename std::make_unsigned<T>::type v = 0;
+    while (s < e && (unsigned)(*s - '0') < 10)
+      v = v * 10 + (*s++ - '0');
+    x = neg ? (T)(0 - v) : (T)v;
+    return true;
+  }
+
+  // First call: map stdin if it is a regular file, else start the reader
+  // thread (ASYNC) or allocate a block (SYNC)
+  void start()
+  {
+    started = true;
+    if (const char *env = getenv("TCA_READER"))
+      mode = strcmp(env, "thread") == 0  ? THREAD
+             : strcmp(env, "async") == 0 ? ASYNC
+                                         : SYNC;
+    struct stat st;
+    if (mode != THREAD && fstat(0, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+    {
+      off_t offset = lseek(0, 0, SEEK_CUR);
+      // Counting: fault the whole input in now, inside the io phase
+      int flags = MAP_PRIVATE | (PerfCounters::instance().enabled ? MAP_POPULATE : 0);
+      void *m = mmap(nullptr, st.st_size, PROT_READ, flags, 0, 0);
+      if (m != MAP_FAILED)
+      {
+        madvise(m, st.st_size, MADV_SEQUENTIAL);
+        map = m;
+        map_len = st.st_size;
+        p = static_cast<const char *>(m) + (offset > 0 ? offset : 0);
+        end = static_cast<const char *>(m) + st.st_size;
+        done = true;
+        return;
+      }
+    }
+    if (mode != SYNC)
+    {
+      async = new AsyncBlocks();
+      return;
+    }
+    cap = BLOCK;
+    buf = static_cast<char *>(malloc(cap));
+    p = end = buf;
+  }
+
+  // Keeps the bytes from 'from' on (a token in progress) at the front of
+  // the buffer and reads more behind them. 'from' and 'p' are moved along.
+  // Returns false if no byte was added.
+  __attribute__((noinline)) bool refill(const char *&from)
+  {
+    PerfIoScope io;
+    if (!started)
+    {
+      start();
+      from = p;
+      if (p != end)
+        return true;
+    }
+    if (done)
+      return false;
+    if (async)
+      return refillAsync(from);
+
+    size_t kept = end - from, offset = p - from;
+    if (kept + BLOCK > cap)
+    {
+      // A token longer than a block: grow instead of cutting it
+      cap = 2 * (kept + BLOCK);
+      char *bigger = static_cast<char *>(malloc(cap));
+      memcpy(bigger, from, kept);
+      free(buf);
+      buf = bigger;
+    }
+    else if (kept)
+    {
+      memmove(buf, from, kept);
+    }
+
+    size_t room = cap - kept;
+    size_t got = fread(buf + kept, 1, room, stdin);
+    if (got < room)
+      done = true;
+    from = buf;
+    p = buf + offset;
+    end = buf + kept + got;
+    return got > 0;
+  }
+
+  // refill() from the reader thread's next slot. The kept bytes go into
+  // the slot's headroom, right in front of its data, and the slot read
+  // so far goes back to the thread. A token longer than the headroom is
+  // joined with the new data in 'buf' instead, and both slots go back.
+  bool refillAsync(const char *&from)
+  {
+    AsyncBlocks &a = *async;
+    AsyncBlocks::Slot &s = a.slot[a.next];
+    AsyncBlocks::wait(s.state, AsyncBlocks::FULL);
+    char *data = s.mem + AsyncBlocks::HEAD;
+    size_t len = s.len, kept = end - from, offset = p - from;
+    bool last = s.last;
+    char *to;
+    if (kept <= AsyncBlocks::HEAD)
+    {
+      to = data - kept;
+      memcpy(to, from, kept);
+      a.release(a.held);
+      a.held = a.next;
+    }
+    else
+    {
+      if (kept + len > cap)
+      {
+        cap = 2 * (kept + len);
+        char *bigger = static_cast<char *>(malloc(cap));
+        memcpy(bigger, from, kept);
+        free(buf);
+        buf = bigger;
+      }
+      else
+      {
+        memmove(buf, from, kept);
+      }
+      memcpy(buf + kept, data, len);
+      to = buf;
+      a.release(a.held);
+      a.release(a.next);
+      a.held = -1;
+    }
+    from = to;
+    p = to + offset;
+    end = to + kept + len;
+    done = last;
+    a.next ^= 1;
+    return len > 0;
+  }
+};
+
+struct BufferedWriter
+{
+  static const int SIZE = 1 << 16;
+  char buf[SIZE];
+  int len = 0;
+  std::string *sink = nullptr; // Output string, or null for stdout
+
+  BufferedWriter() = default;
+  explicit BufferedWriter(std::string &out) : sink(&out) {}
+  BufferedWriter(const BufferedWriter &) = delete;
+  BufferedWriter &operator=(const BufferedWriter &) = delete;
+  ~BufferedWriter() { flush(); }
+
+  void flush()
+  {
+    if (len)
+      emit(buf, len);
+    len = 0;
+  }
+
+  // Hands n bytes to the sink or to stdout (counted as I/O)
+  void emit(const char *s, size_t n)
+  {
+    if (sink)
+    {
+      sink->append(s, n);
+      return;
+    }
+    PerfIoScope io;
+    fwrite(s, 1, n, stdout);
+  }
+
+  inline void put(char c)
+  {
+    if (len == SIZE)
+      flush();
+    buf[len++] = c;
+  }
+
+  inline void write(std::string_view s)
+  {
+    if (s.size() > (size_t)(SIZE - len))
+    {
+      flush();
+      if (s.size() > (size_t)SIZE)
+      {
+        emit(s.data(), s.size());
+        return;
+      }
+    }
+    memcpy(buf + len, s.data(), s.size());
+    len += (int)s.size();
+  }
+
+  template <class T>
+  inline void writeInt(T v)
+  {
+    if (len > SIZE - 24)
+      flush();
+    typename std::make_unsigned<T>::type u = v;
+    if constexpr (std::is_signed<T>::value)
+    {
+      if (v < 0)
+      {
+        buf[len++] = '-';
+        u = 0 - u;
+      }
+    }
+    char tmp[24];
+    int n = 0;
+    do
+    {
+      tmp[n++] = char('0' + u % 10);
+      u /= 10;
+    } while (u);
+    while (n)
+      buf[len++] = tmp[--n];
+  }
+
+  // printf("%.*f", digits, v) for digits in [0, 9].
+  // The scaled value is rounded in double. Below 2^32 its error is under
+  // 1e-6, so only a value within 1e-6 of a rounding tie (where printf
+  // looks at the exact binary value) or a large / non-finite one goes
+  // through snprintf.
+  void writeFixed(double v, int digits)
+  {
+    static const double POW10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9};
+    double scaled = fabs(v) * POW10[digits];
+    double frac = scaled - floor(scaled);
+    if (!(scaled < 4e9) || fabs(frac - 0.5) < 1e-6)
+    {
+      char tmp[512];
+      int n = snprintf(tmp, sizeof(tmp), "%.*f", digits, v);
+      write(std::string_view(tmp, n < (int)sizeof(tmp) ? n : sizeof(tmp) - 1));
+      return;
+    }
+
+    unsigned long long units = (unsigned long long)floor(scaled + 0.5);
+    unsigned long long p = (unsigned long long)POW10[digits];
+    if (std::signbit(v))
+      put('-');
+    writeInt(units / p);
+    if (digits)
+    {
+      if (len > SIZE - 12)
+        flush();
+      buf[len++] = '.';
+      unsigned long long rest = units % p;
+      for (int i = digits - 1; i >= 0; i--)
+      {
+        buf[len + i] = char('0' + rest % 10);
+        rest /= 10;
+      }
+      len += digits;
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,238 @@
+/**
+ * Hardware performance counters for the C++ solutions (Linux perf_event_open).
+ * Language: C++17 (header-only)
+ *
+ * Off unless the environment variable TCA_PERF_OUT names a file
+ * (tools/run_bench.py --perf sets it): one getenv() at the first read, then
+ * every hook is a single branch on 'enabled'.
+ *
+ * When on, eight counters run for the whole process, each opened alone
+ * (a group fails as a whole if one event is missing) and scaled by
+ * time_enabled / time_running if the kernel multiplexes them:
+ *   cycles, instructions, branch_misses, l1d_read_misses,
+ *   llc_read_misses, dtlb_read_misses (hardware), task_clock_ns,
+ *   page_faults (software)
+ * Their deltas are split into two phases:
+ *   io    - inside a PerfIoScope: fastio.hpp wraps the mmap / fread of
+ *           BlockReader and the fwrite of BufferedWriter in one
+ *   solve - everything else (parsing included)
+ * With counters on, BlockReader maps stdin with MAP_POPULATE, so the
+ * page faults of a file input are taken in the io phase instead of being
+ * spread over the solve phase.
+ *
+ * At exit the totals are written to TCA_PERF_OUT as one JSON object:
+ *   {"kernel":true,"solve":{"cycles":...,...},"io":{...},
+ *    "unavailable":{"llc_read_misses":"No such file or directory",...}}
+ * An event the kernel refuses (no PMU in a VM, perf_event_paranoid,
+ * seccomp) is listed under "unavailable" and left out of the phases.
+ * Kernel-side counting is tried first; if it is not allowed, the
+ * counters are reopened user-only and "kernel" is false.
+ */
+
+#ifndef BEECROWD_PERF_HPP
+#define BEECROWD_PERF_HPP
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+struct PerfCounters
+{
+  enum
+  {
+    SOLVE,
+    IO,
+    PHASES
+  };
+  static const int EVENTS = 8;
+
+  struct Event
+  {
+    const char *name;
+    uint32_t type;
+    uint64_t config;
+  };
+
+  static constexpr uint64_t cacheMiss(uint64_t cache)
+  {
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+  }
+
+  static const Event &event(int i)
+  {
+    static const Event events[EVENTS] = {
+        {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {"branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        {"l1d_read_misses", PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_L1D)},
+        {"llc_read_misses", PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_LL)},
+        {"dtlb_read_misses", PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_DTLB)},
+        {"task_clock_ns", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK},
+        {"page_faults", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+    };
+    return events[i];
+  }
+
+  bool enabled = false;
+  bool kernel = true; // Kernel-side work is counted too
+  const char *out_path = nullptr;
+  int fd[EVENTS];
+  int error[EVENTS];       // errno of a refused event, 0 if open
+  double last[EVENTS];     // Scaled value at the last phase switch
+  double total[PHASES][EVENTS];
+  int phase = SOLVE;
+  int io_depth = 0;
+
+  // Never destroyed: the report runs from atexit(), and BufferedWriter
+  // globals may still flush through the hooks after it.
+  static PerfCounters &instance()
+  {
+    static PerfCounters *counters = new PerfCounters();
+    return *counters;
+  }
+
+  PerfCounters()
+  {
+    memset(total, 0, sizeof total);
+    memset(last, 0, sizeof last);
+    for (int i = 0; i < EVENTS; ++i)
+      fd[i] = -1, error[i] = 0;
+
+    out_path = getenv("TCA_PERF_OUT");
+    if (!out_path || !*out_path)
+      return;
+    enabled = true;
+
+    openAll();
+    bool refused = false;
+    for (int i = 0; i < EVENTS; ++i)
+      refused |= error[i] == EACCES || error[i] == EPERM;
+    if (refused)
+    {
+      // perf_event_paranoid >= 2: user-space counting only
+      closeAll();
+      kernel = false;
+      openAll();
+    }
+    atexit([] { instance().report(); });
+  }
+
+  void openAll()
+  {
+    for (int i = 0; i < EVENTS; ++i)
+    {
+      struct perf_event_attr attr;
+      memset(&attr, 0, sizeof attr);
+      attr.size = sizeof attr;
+      attr.type = event(i).type;
+      attr.config = event(i).config;
+      attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+      attr.inherit = 1; // Threads spawned later (1346 solution_parallel)
+      attr.exclude_kernel = !kernel;
+      attr.exclude_hv = 1;
+      fd[i] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+      error[i] = fd[i] < 0 ? errno : 0;
+    }
+  }
+
+  void closeAll()
+  {
+    for (int i = 0; i < EVENTS; ++i)
+    {
+      if (fd[i] >= 0)
+        close(fd[i]);
+      fd[i] = -1;
+    }
+  }
+
+  // Adds the counts since the last switch to the current phase
+  void sample()
+  {
+    for (int i = 0; i < EVENTS; ++i)
+    {
+      uint64_t v[3]; // value, time_enabled, time_running
+      if (fd[i] < 0 || read(fd[i], v, sizeof v) != (ssize_t)sizeof v)
+        continue;
+      double scaled = v[2] ? (double)v[0] * v[1] / v[2] : 0.0;
+      total[phase][i] += scaled - last[i];
+      last[i] = scaled;
+    }
+  }
+
+  void enterIo()
+  {
+    if (io_depth++ == 0)
+    {
+      sample();
+      phase = IO;
+    }
+  }
+
+  void leaveIo()
+  {
+    if (--io_depth == 0)
+    {
+      sample();
+      phase = SOLVE;
+    }
+  }
+
+  void report()
+  {
+    sample();
+    FILE *f = fopen(out_path, "w");
+    if (!f)
+      return;
+    static const char *const PHASE_NAMES[PHASES] = {"solve", "io"};
+    fprintf(f, "{\"kernel\":%s", kernel ? "true" : "false");
+    for (int ph = 0; ph < PHASES; ++ph)
+    {
+      fprintf(f, ",\"%s\":{", PHASE_NAMES[ph]);
+      bool first = true;
+      for (int i = 0; i < EVENTS; ++i)
+      {
+        if (fd[i] < 0)
+          continue;
+        fprintf(f, "%s\"%s\":%.0f", first ? "" : ",", event(i).name, total[ph][i]);
+        first = false;
+      }
+      fprintf(f, "}");
+    }
+    fprintf(f, ",\"unavailable\":{");
+    bool first = true;
+    for (int i = 0; i < EVENTS; ++i)
+    {
+      if (fd[i] >= 0)
+        continue;
+      fprintf(f, "%s\"%s\":\"%s\"", first ? "" : ",", event(i).name, strerror(error[i]));
+      first = false;
+    }
+    fprintf(f, "}}\n");
+    fclose(f);
+  }
+};
+
+// Counts the enclosed code as I/O (no-op unless TCA_PERF_OUT is set)
+struct PerfIoScope
+{
+  PerfCounters &counters;
+  PerfIoScope() : counters(PerfCounters::instance())
+  {
+    if (counters.enabled)
+      counters.enterIo();
+  }
+  ~PerfIoScope()
+  {
+    if (counters.enabled)
+      counters.leaveIo();
+  }
+  PerfIoScope(const PerfIoScope &) = delete;
+  PerfIoScope &operator=(const PerfIoScope &) = delete;
+};
+
+#endif // BEECROWD_PERF_HPP
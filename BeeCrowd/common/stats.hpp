@@ -0,0 +1,199 @@
+/**
+ * Compile-time instrumentation for the search-heavy solutions.
+ * Language: C++17 (header-only)
+ *
+ * Two policies with the same interface:
+ *   NoStats   - every call is an empty inline function: the default
+ *               build compiles to exactly the uninstrumented code
+ *   CaseStats - per-case counters and log2 histograms, one JSON object
+ *               per case on stderr, then one with the totals at exit
+ * `Stats` is CaseStats when compiled with -DTCA_STATS, NoStats otherwise.
+ *
+ *   enum { C_CALLS, C_HITS };   enum { H_DEPTH };
+ *   Stats stats{{"calls", "memo_hits"}, {"depth"}};
+ *
+ *   stats.add(C_CALLS);            counter += 1 (or += n)
+ *   stats.sample(H_DEPTH, v);      one value into a histogram
+ *   auto scope = stats.enter(h);   recursion depth + 1 until the scope
+ *                                  ends; the new depth goes into h
+ *   stats.endCase();               print this case, fold it into totals
+ *
+ * Output (one line each, keys in declaration order):
+ *   {"case":1,"calls":42,"memo_hits":7,"depth":{"n":42,"sum":130,"max":6,"log2":[1,2,8,31]}}
+ *   {"case":"total","cases":1,...}
+ * log2[0] counts the zeros, log2[k] the values in [2^(k-1), 2^k).
+ * stdout stays the judge's answer; stderr holds the stats.
+ */
+
+#ifndef BEECROWD_STATS_HPP
+#define BEECROWD_STATS_HPP
+
+#include <cstdio>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+struct NoStats
+{
+  static constexpr bool enabled = false;
+
+  // Trivial, so a recursive call before it goes out of scope is still a
+  // tail call; the attribute silences unused-variable warnings instead
+  // of a user-provided destructor.
+  struct __attribute__((unused)) Scope
+  {
+  };
+
+  NoStats(std::initializer_list<const char *>, std::initializer_list<const char *> = {}) {}
+
+  inline void add(int, long long = 1) {}
+  inline void sample(int, long long) {}
+  inline Scope enter(int) { return Scope(); }
+  inline void endCase() {}
+};
+
+struct CaseStats
+{
+  static constexpr bool enabled = true;
+  static const int BUCKETS = 64;
+
+  struct Histogram
+  {
+    long long n = 0, sum = 0, max = 0;
+    long long log2[BUCKETS] = {};
+
+    void add(long long v)
+    {
+      n++;
+      sum += v;
+      if (v > max)
+        max = v;
+      log2[v <= 0 ? 0 : 64 - __builtin_clzll((unsigned long long)v)]++;
+    }
+
+    void merge(const Histogram &h)
+    {
+      n += h.n;
+      sum += h.sum;
+      if (h.max > max)
+        max = h.max;
+      for (int k = 0; k < BUCKETS; ++k)
+        log2[k] += h.log2[k];
+    }
+  };
+
+  // Restores the depth when the recursive call returns
+  struct Scope
+  {
+    CaseStats *s;
+    explicit Scope(CaseStats *owner) : s(owner) {}
+    Scope(const Scope &) = delete;
+    ~Scope() { s->depth--; }
+  };
+
+  std::vector<const char *> counter_names, histogram_names;
+  std::vector<long long> counters, total_counters;
+  std::vector<Histogram> histograms, total_histograms;
+  long long cases = 0;
+  long long depth = 0;
+  bool dirty = false; // Something was recorded since the last endCase()
+
+  CaseStats(std::initializer_list<const char *> counter_list,
+            std::initializer_list<const char *> histogram_list = {})
+      : counter_names(counter_list), histogram_names(histogram_list),
+        counters(counter_names.size()), total_counters(counter_names.size()),
+        histograms(histogram_names.size()), total_histograms(histogram_names.size())
+  {
+  }
+  CaseStats(const CaseStats &) = delete;
+  CaseStats &operator=(const CaseStats &) = delete;
+
+  // Work recorded after the last case (or by a driver without cases)
+  // still shows up: it becomes one more case before the totals.
+  ~CaseStats()
+  {
+    if (dirty)
+      endCase();
+    line.clear();
+    append("{\"case\":\"total\",\"cases\":%lld", cases);
+    print(total_counters, total_histograms);
+  }
+
+  inline void add(int id, long long n = 1)
+  {
+    counters[id] += n;
+    dirty = true;
+  }
+
+  inline void sample(int id, long long v)
+  {
+    histograms[id].add(v);
+    dirty = true;
+  }
+
+  // C++17 guaranteed elision: the Scope is built in place, never copied
+  inline Scope enter(int id)
+  {
+    sample(id, ++depth);
+    return Scope(this);
+  }
+
+  void endCase()
+  {
+    cases++;
+    line.clear();
+    append("{\"case\":%lld", cases);
+    print(counters, histograms);
+    for (size_t i = 0; i < counters.size(); ++i)
+    {
+      total_counters[i] += counters[i];
+      counters[i] = 0;
+    }
+    for (size_t i = 0; i < histograms.size(); ++i)
+    {
+      total_histograms[i].merge(histograms[i]);
+      histograms[i] = Histogram();
+    }
+    dirty = false;
+  }
+
+  // Lines are built in 'line' and written with one fwrite: stderr is
+  // unbuffered, and a write() per field would dominate short cases.
+  std::string line;
+
+  template <class... Args>
+  void append(const char *fmt, Args... args)
+  {
+    char tmp[128];
+    int n = snprintf(tmp, sizeof tmp, fmt, args...);
+    line.append(tmp, n < (int)sizeof tmp ? n : sizeof tmp - 1);
+  }
+
+  // Completes the JSON object opened in 'line' and writes it
+  void print(const std::vector<long long> &c, const std::vector<Histogram> &h)
+  {
+    for (size_t i = 0; i < c.size(); ++i)
+      append(",\"%s\":%lld", counter_names[i], c[i]);
+    for (size_t i = 0; i < h.size(); ++i)
+    {
+      append(",\"%s\":{\"n\":%lld,\"sum\":%lld,\"max\":%lld,\"log2\":[",
+             histogram_names[i], h[i].n, h[i].sum, h[i].max);
+      int top = BUCKETS;
+      while (top > 1 && h[i].log2[top - 1] == 0)
+        top--;
+      for (int k = 0; k < top; ++k)
+        append(k ? ",%lld" : "%lld", h[i].log2[k]);
+      line += "]}";
+    }
+    line += "}\n";
+    fwrite(line.data(), 1, line.size(), stderr);
+  }
+};
+
+#ifdef TCA_STATS
+typedef CaseStats Stats;
+#else
+typedef NoStats Stats;
+#endif
+
+#endif // BEECROWD_STATS_HPP
@@ -0,0 +1,174 @@
+/**
+ * Every problem's engine in one translation unit, looked up by format.
+ * Language: C++17 (header-only, include it from one .cpp per program)
+ *
+ *   std::unique_ptr<AnyEngine> e = makeEngine("1058");
+ *   std::string out = e->solve(input);
+ *
+ * The formats are those of tools/gen_inputs.py and engines.tsv:
+ *   1023 1034 1053 1058 1141 1231 1231_kdict 1324 1324_nbody 1346 1530
+ * (1530 is the SAM). The other variants of a format (solution_batch.cpp,
+ * solution_bitset.cpp, ...) are engines too, but a format has one. Each solution file is included in its own
+ * namespace, as in 1530/bench/bench_engines.cpp: every header they use is
+ * included first, so their includes are no-ops, and <P>_NO_MAIN leaves
+ * out their main(). AnyEngine hides the engine type behind one virtual
+ * solve() (common/engine.hpp).
+ *
+ * Used by batch/batch_runner.cpp and by the C ABI in lib/tca_engines.cpp.
+ */
+
+#ifndef BEECROWD_ALL_ENGINES_HPP
+#define BEECROWD_ALL_ENGINES_HPP
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <array>
+#include <queue>
+#include <set>
+#include <map>
+#include <unordered_map>
+#include <algorithm>
+#include <numeric>
+#include <iterator>
+#include <limits>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include "../common/fastio.hpp"
+#include "../common/stats.hpp"
+#include "../common/engine.hpp"
+
+namespace p1023
+{
+#define P1023_NO_MAIN
+#include "../1023-Drought/solution.cpp"
+}
+
+namespace p1034
+{
+#define P1034_NO_MAIN
+#include "../1034-Ice-Statues-Festival/solution.cpp"
+}
+
+namespace p1053
+{
+#define P1053_NO_MAIN
+#include "../1053-Continuous-Drawing/solution.cpp"
+}
+
+namespace p1058
+{
+#define P1058_NO_MAIN
+#include "../1058-Independent-Attacking-Zones/solution.cpp"
+}
+
+namespace p1141
+{
+#define P1141_NO_MAIN
+#include "../1141-Growing-Strings/solution.cpp"
+}
+
+namespace p1231
+{
+#define P1231_NO_MAIN
+#include "../1231-Words/solution.cpp"
+}
+
+namespace p1231_kdict
+{
+#define KDICT_NO_MAIN
+#include "../1231-Words/solution_kdict.cpp"
+}
+
+namespace p1324
+{
+#define P1324_NO_MAIN
+#include "../1324-Higgs-Boson/solution.cpp"
+}
+
+namespace p1324_nbody
+{
+#define NBODY_NO_MAIN
+#include "../1324-Higgs-Boson/solution_nbody.cpp"
+}
+
+namespace p1346
+{
+#define P1346_NO_MAIN
+#include "../1346-Child-Play/solution.cpp"
+}
+
+namespace p1530
+{
+#define SAM_NO_MAIN
+#include "../1530-How-Many-Substrings/solution_SAM.cpp"
+}
+
+// One engine of any problem
+struct AnyEngine
+{
+  virtual ~AnyEngine() = default;
+  virtual std::string solve(std::string_view input) = 0;
+};
+
+template <class Engine>
+struct EngineOf : AnyEngine
+{
+  Engine engine;
+  std::string solve(std::string_view input) override { return engine.solve(input); }
+};
+
+struct EngineFormat
+{
+  const char *format;
+  AnyEngine *(*make)();
+};
+
+template <class Engine>
+AnyEngine *newEngine()
+{
+  return new EngineOf<Engine>();
+}
+
+const EngineFormat ENGINE_FORMATS[] = {
+    {"1023", newEngine<p1023::DroughtEngine>},
+    {"1034", newEngine<p1034::IceStatuesEngine>},
+    {"1053", newEngine<p1053::DrawingEngine>},
+    {"1058", newEngine<p1058::AttackingZonesEngine>},
+    {"1141", newEngine<p1141::GrowingStringsEngine>},
+    {"1231", newEngine<p1231::WordsEngine>},
+    {"1231_kdict", newEngine<p1231_kdict::KDictEngine>},
+    {"1324", newEngine<p1324::HiggsBosonEngine>},
+    {"1324_nbody", newEngine<p1324_nbody::NBodyEngine>},
+    {"1346", newEngine<p1346::ChildPlayEngine>},
+    {"1530", newEngine<p1530::SubstringsEngine>},
+};
+const int ENGINE_COUNT = sizeof(ENGINE_FORMATS) / sizeof(ENGINE_FORMATS[0]);
+
+// Index of 'format' in ENGINE_FORMATS, or -1 if no engine reads it
+inline int findEngineFormat(std::string_view format)
+{
+  for (int i = 0; i < ENGINE_COUNT; ++i)
+  {
+    if (format == ENGINE_FORMATS[i].format)
+      return i;
+  }
+  return -1;
+}
+
+// A new engine for 'format', or null
+inline std::unique_ptr<AnyEngine> makeEngine(std::string_view format)
+{
+  int i = findEngineFormat(format);
+  return std::unique_ptr<AnyEngine>(i < 0 ? nullptr : ENGINE_FORMATS[i].make());
+}
+
+#endif // BEECROWD_ALL_ENGINES_HPP
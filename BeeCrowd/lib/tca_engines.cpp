@@ -0,0 +1,86 @@
+/**
+ * libtca_engines.so: the engines of lib/all_engines.hpp behind the C ABI
+ * of tca_engines.h. Built with hidden visibility, so only the tca_*
+ * functions are exported.
+ */
+
+#include <exception>
+#include <memory>
+#include <string>
+#include "all_engines.hpp"
+#include "tca_engines.h"
+
+struct tca_engine
+{
+  std::unique_ptr<AnyEngine> engine;
+  std::string output; // Last answer, handed out by pointer
+  std::string error;
+};
+
+// "1023 1034 ... 1530", built once
+static const std::string &problemList()
+{
+  static const std::string list = []
+  {
+    std::string s;
+    for (int i = 0; i < ENGINE_COUNT; ++i)
+    {
+      if (i)
+        s += ' ';
+      s += ENGINE_FORMATS[i].format;
+    }
+    return s;
+  }();
+  return list;
+}
+
+extern "C"
+{
+  int tca_abi_version(void) { return TCA_ABI_VERSION; }
+
+  const char *tca_problems(void) { return problemList().c_str(); }
+
+  tca_engine *tca_engine_new(const char *problem)
+  {
+    if (!problem)
+      return nullptr;
+    try
+    {
+      std::unique_ptr<AnyEngine> engine = makeEngine(problem);
+      if (!engine)
+        return nullptr;
+      tca_engine *handle = new tca_engine();
+      handle->engine = std::move(engine);
+      return handle;
+    }
+    catch (const std::exception &)
+    {
+      return nullptr;
+    }
+  }
+
+  void tca_engine_free(tca_engine *engine) { delete engine; }
+
+  int tca_engine_solve(tca_engine *engine, const char *input, size_t input_len,
+                       const char **output, size_t *output_len)
+  {
+    if (!engine || (!input && input_len) || !output || !output_len)
+      return -1;
+    try
+    {
+      engine->output = engine->engine->solve(std::string_view(input ? input : "", input_len));
+      engine->error.clear();
+      *output = engine->output.data();
+      *output_len = engine->output.size();
+      return 0;
+    }
+    catch (const std::exception &e)
+    {
+      engine->output.clear();
+      engine->error = e.what();
+      return -1;
+    }
+  }
+
+  const char *tca_engine_error(const tca_engine *engine) { return engine ? engine->error.c_str() : ""; }
+}
@@ -0,0 +1,64 @@
+/**
+ * C ABI of the C++ engines (libtca_engines.so).
+ * Language: C89-compatible header, the library itself is C++17
+ *
+ *   tca_engine *e = tca_engine_new("1058");
+ *   const char *out; size_t out_len;
+ *   if (tca_engine_solve(e, input, input_len, &out, &out_len) == 0)
+ *     fwrite(out, 1, out_len, stdout);
+ *   tca_engine_free(e);
+ *
+ * The input is the judge's input of that problem, as bytes (no NUL
+ * needed). The output is the judge's answer; it belongs to the engine
+ * and stays valid until the next solve or free of that engine.
+ *
+ * An engine answers any number of inputs, reusing its memory between
+ * them. It is not thread-safe: use one engine per thread (engines share
+ * nothing). No C++ exception crosses the ABI, and no engine ends the
+ * process: a failure (e.g. out of memory) is a -1 from tca_engine_solve().
+ *
+ * Wrappers: lib/tca_engines.py (ctypes), lib/tca_engines.js (Node).
+ * Only additions are allowed without bumping TCA_ABI_VERSION.
+ */
+
+#ifndef TCA_ENGINES_H
+#define TCA_ENGINES_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define TCA_ABI_VERSION 1
+
+#define TCA_EXPORT __attribute__((visibility("default")))
+
+typedef struct tca_engine tca_engine;
+
+/* TCA_ABI_VERSION of the library (compare it with the header's) */
+TCA_EXPORT int tca_abi_version(void);
+
+/* The problems with an engine, space-separated: "1023 1034 ... 1530" */
+TCA_EXPORT const char *tca_problems(void);
+
+/* A new engine, or NULL if no engine reads 'problem' (or out of memory) */
+TCA_EXPORT tca_engine *tca_engine_new(const char *problem);
+
+/* Frees the engine and its last output; NULL is ignored */
+TCA_EXPORT void tca_engine_free(tca_engine *engine);
+
+/* Answers one input. Returns 0 and sets *output / *output_len, or -1
+   (then tca_engine_error() says why). */
+TCA_EXPORT int tca_engine_solve(tca_engine *engine, const char *input, size_t input_len,
+                                const char **output, size_t *output_len);
+
+/* Message of the last failed solve of this engine ("" if none) */
+TCA_EXPORT const char *tca_engine_error(const tca_engine *engine);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TCA_ENGINES_H */
@@ -0,0 +1,89 @@
+"use strict";
+
+/**
+ * Node wrapper of libtca_engines.so: the C++ engines, called in-process
+ * through the addon tca_engines.node (lib/tca_engines_node.cpp).
+ *
+ *   const { Engine } = require("./tca_engines");
+ *   const engine = new Engine("1058");
+ *   const answer = engine.solve(judgeInput); // string or Buffer in, string out
+ *   engine.close();
+ *
+ * An Engine answers any number of inputs and keeps its memory between
+ * them (one per worker thread). close() frees it now, the GC otherwise.
+ *
+ * The addon is found through, in order: the environment variable
+ * TCA_ENGINES_NODE, then <repo>/build/lib/tca_engines.node (the CMake
+ * target tca_engines_node, built when the Node-API headers are found).
+ *
+ * As a script it answers stdin, like the judge binaries:
+ *   node tca_engines.js <problem> [--addon PATH] < input
+ */
+
+const fs = require("fs");
+const path = require("path");
+
+const ABI_VERSION = 1; // TCA_ABI_VERSION of tca_engines.h
+const DEFAULT_ADDON = path.join(__dirname, "..", "..", "build", "lib", "tca_engines.node");
+
+let addon = null;
+
+function load(addonPath) {
+  if (addon === null) {
+    const file = path.resolve(addonPath || process.env.TCA_ENGINES_NODE || DEFAULT_ADDON);
+    const loaded = require(file);
+    if (loaded.abiVersion() !== ABI_VERSION) {
+      throw new Error(`${file} has ABI version ${loaded.abiVersion()}, expected ${ABI_VERSION}`);
+    }
+    addon = loaded;
+  }
+  return addon;
+}
+
+// The problems with an engine, e.g. ["1023", "1034", ...]
+function problems(addonPath) {
+  return load(addonPath).problems().split(" ");
+}
+
+class Engine {
+  constructor(problem, addonPath) {
+    this.addon = load(addonPath);
+    this.problem = String(problem);
+    this.handle = this.addon.create(this.problem);
+    if (this.handle === null) {
+      throw new Error(`no engine for problem ${this.problem} (have: ${problems().join(" ")})`);
+    }
+  }
+
+  // Answers one judge input (string or Buffer)
+  solve(input) {
+    if (this.handle === null) throw new Error("engine is closed");
+    return this.addon.solve(this.handle, input);
+  }
+
+  close() {
+    if (this.handle !== null) {
+      this.addon.free(this.handle);
+      this.handle = null;
+    }
+  }
+}
+
+module.exports = { Engine, problems, load };
+
+if (require.main === module) {
+  const args = process.argv.slice(2);
+  let addonPath;
+  const at = args.indexOf("--addon");
+  if (at >= 0) {
+    addonPath = args[at + 1];
+    args.splice(at, 2);
+  }
+  if (args.length !== 1) {
+    process.stderr.write("usage: node tca_engines.js <problem> [--addon PATH] < input\n");
+    process.exit(2);
+  }
+  const engine = new Engine(args[0], addonPath);
+  process.stdout.write(engine.solve(fs.readFileSync(0)));
+  engine.close();
+}
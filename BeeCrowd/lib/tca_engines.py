@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+"""
+ctypes wrapper of libtca_engines.so: the C++ engines, called in-process.
+
+    from tca_engines import Engine
+    with Engine('1058') as engine:
+        answer = engine.solve(judge_input)      # str in, str out
+        raw = engine.solve(judge_input_bytes)   # bytes in, bytes out
+
+An Engine answers any number of inputs and keeps its memory between
+them. It is not thread-safe: use one per thread.
+
+The library is found through, in order: the `lib` argument of Engine /
+load(), the environment variable TCA_ENGINES_LIB, then
+<repo>/build/lib/libtca_engines.so (the CMake target tca_engines).
+
+As a script it answers stdin, like the judge binaries:
+    tca_engines.py <problem> [--lib PATH] < input
+"""
+
+import argparse
+import ctypes
+import os
+import sys
+
+ABI_VERSION = 1  # TCA_ABI_VERSION of tca_engines.h
+ROOT = os.path.dirname(os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+DEFAULT_LIB = os.path.join(ROOT, 'build', 'lib', 'libtca_engines.so')
+
+_lib = None
+
+
+def load(lib=None):
+    """Loads the library once and declares the C signatures."""
+    global _lib
+    if _lib is not None:
+        return _lib
+    path = lib or os.environ.get('TCA_ENGINES_LIB') or DEFAULT_LIB
+    dll = ctypes.CDLL(path)
+
+    dll.tca_abi_version.restype = ctypes.c_int
+    dll.tca_abi_version.argtypes = []
+    dll.tca_problems.restype = ctypes.c_char_p
+    dll.tca_problems.argtypes = []
+    dll.tca_engine_new.restype = ctypes.c_void_p
+    dll.tca_engine_new.argtypes = [ctypes.c_char_p]
+    dll.tca_engine_free.restype = None
+    dll.tca_engine_free.argtypes = [ctypes.c_void_p]
+    dll.tca_engine_solve.restype = ctypes.c_int
+    dll.tca_engine_solve.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_size_t,
+                                     ctypes.POINTER(ctypes.c_char_p),
+                                     ctypes.POINTER(ctypes.c_size_t)]
+    dll.tca_engine_error.restype = ctypes.c_char_p
+    dll.tca_engine_error.argtypes = [ctypes.c_void_p]
+
+    if dll.tca_abi_version() != ABI_VERSION:
+        raise OSError('%s has ABI version %d, expected %d'
+                      % (path, dll.tca_abi_version(), ABI_VERSION))
+    _lib = dll
+    return _lib
+
+
+def problems(lib=None):
+    """The problems with an engine, e.g. ['1023', '1034', ...]."""
+    return load(lib).tca_problems().decode().split()
+
+
+class Engine:
+    def __init__(self, problem, lib=None):
+        self._lib = load(lib)
+        self._handle = self._lib.tca_engine_new(str(problem).encode())
+        if not self._handle:
+            raise ValueError('no engine for problem %r (have: %s)'
+                             % (problem, ' '.join(problems())))
+        self.problem = str(problem)
+
+    def solve(self, data):
+        """Answers one judge input: str -> str, bytes -> bytes."""
+        if self._handle is None:
+            raise ValueError('engine is closed')
+        raw = data.encode() if isinstance(data, str) else bytes(data)
+        out = ctypes.c_char_p()
+        out_len = ctypes.c_size_t()
+        if self._lib.tca_engine_solve(self._handle, raw, len(raw),
+                                      ctypes.byref(out), ctypes.byref(out_len)) != 0:
+            raise RuntimeError('engine %s: %s' % (
+                self.problem, self._lib.tca_engine_error(self._handle).decode()))
+        answer = ctypes.string_at(out, out_len.value)  # Copied: the engine reuses its buffer
+        return answer.decode() if isinstance(data, str) else answer
+
+    def close(self):
+        if self._handle is not None:
+            self._lib.tca_engine_free(self._handle)
+            self._handle = None
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.close()
+
+    def __del__(self):
+        if getattr(self, '_handle', None) is not None:
+            self.close()
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    ap.add_argument('problem')
+    ap.add_argument('--lib', help='path of libtca_engines.so')
+    args = ap.parse_args()
+
+    with Engine(args.problem, args.lib) as engine:
+        sys.stdout.buffer.write(engine.solve(sys.stdin.buffer.read()))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
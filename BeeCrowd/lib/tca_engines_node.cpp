@@ -0,0 +1,174 @@
+/**
+ * Node addon (tca_engines.node): the C ABI of tca_engines.h for
+ * lib/tca_engines.js. Plain Node-API, so one build loads in any Node
+ * version with Node-API 3 or later, without node-gyp.
+ *
+ *   create(problem)        -> handle (null if no engine reads it)
+ *   solve(handle, input)   -> string; input is a string or a Buffer
+ *   free(handle)           frees now (the GC frees it otherwise)
+ *   problems()             -> "1023 1034 ... 1530"
+ *   abiVersion()           -> TCA_ABI_VERSION of the library
+ */
+
+#define NAPI_VERSION 3
+#include <node_api.h>
+#include <string>
+#include "tca_engines.h"
+
+// Returns nullptr from the calling function if a Node-API call failed;
+// the pending exception is then thrown in JavaScript.
+#define NAPI_CHECK(call)   \
+  do                       \
+  {                        \
+    if ((call) != napi_ok) \
+      return nullptr;      \
+  } while (0)
+
+// The engine behind a handle; the holder lets free() run before the GC
+struct Holder
+{
+  tca_engine *engine;
+};
+
+static void finalize(napi_env, void *data, void *)
+{
+  Holder *h = static_cast<Holder *>(data);
+  tca_engine_free(h->engine);
+  delete h;
+}
+
+static napi_value throwError(napi_env env, const char *message)
+{
+  napi_throw_error(env, nullptr, message);
+  return nullptr;
+}
+
+// Reads a string argument into 'out'
+static bool readString(napi_env env, napi_value value, std::string &out)
+{
+  size_t len = 0;
+  if (napi_get_value_string_utf8(env, value, nullptr, 0, &len) != napi_ok)
+    return false;
+  out.resize(len + 1);
+  if (napi_get_value_string_utf8(env, value, &out[0], len + 1, &len) != napi_ok)
+    return false;
+  out.resize(len);
+  return true;
+}
+
+static Holder *holderOf(napi_env env, napi_value value)
+{
+  void *data = nullptr;
+  if (napi_get_value_external(env, value, &data) != napi_ok || !data)
+    return nullptr;
+  return static_cast<Holder *>(data);
+}
+
+static napi_value create(napi_env env, napi_callback_info info)
+{
+  size_t argc = 1;
+  napi_value argv[1];
+  NAPI_CHECK(napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+  std::string problem;
+  if (argc < 1 || !readString(env, argv[0], problem))
+    return throwError(env, "create(problem): problem must be a string");
+
+  napi_value result;
+  tca_engine *engine = tca_engine_new(problem.c_str());
+  if (!engine)
+  {
+    NAPI_CHECK(napi_get_null(env, &result));
+    return result;
+  }
+  Holder *h = new Holder{engine};
+  if (napi_create_external(env, h, finalize, nullptr, &result) != napi_ok)
+  {
+    finalize(env, h, nullptr);
+    return nullptr;
+  }
+  return result;
+}
+
+static napi_value solve(napi_env env, napi_callback_info info)
+{
+  size_t argc = 2;
+  napi_value argv[2];
+  NAPI_CHECK(napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+  Holder *h = argc == 2 ? holderOf(env, argv[0]) : nullptr;
+  if (!h)
+    return throwError(env, "solve(handle, input): not an engine handle");
+  if (!h->engine)
+    return throwError(env, "solve(handle, input): engine is freed");
+
+  // A Buffer is read in place, a string is copied out as UTF-8
+  const char *input = nullptr;
+  size_t input_len = 0;
+  std::string copy;
+  bool is_buffer = false;
+  NAPI_CHECK(napi_is_buffer(env, argv[1], &is_buffer));
+  if (is_buffer)
+  {
+    void *data = nullptr;
+    NAPI_CHECK(napi_get_buffer_info(env, argv[1], &data, &input_len));
+    input = static_cast<const char *>(data);
+  }
+  else if (readString(env, argv[1], copy))
+  {
+    input = copy.data();
+    input_len = copy.size();
+  }
+  else
+  {
+    return throwError(env, "solve(handle, input): input must be a string or a Buffer");
+  }
+
+  const char *output;
+  size_t output_len;
+  if (tca_engine_solve(h->engine, input, input_len, &output, &output_len) != 0)
+    return throwError(env, tca_engine_error(h->engine));
+  napi_value result;
+  NAPI_CHECK(napi_create_string_utf8(env, output, output_len, &result));
+  return result;
+}
+
+static napi_value freeEngine(napi_env env, napi_callback_info info)
+{
+  size_t argc = 1;
+  napi_value argv[1];
+  NAPI_CHECK(napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+  Holder *h = argc == 1 ? holderOf(env, argv[0]) : nullptr;
+  if (!h)
+    return throwError(env, "free(handle): not an engine handle");
+  tca_engine_free(h->engine);
+  h->engine = nullptr;
+  return nullptr;
+}
+
+static napi_value problems(napi_env env, napi_callback_info)
+{
+  napi_value result;
+  NAPI_CHECK(napi_create_string_utf8(env, tca_problems(), NAPI_AUTO_LENGTH, &result));
+  return result;
+}
+
+static napi_value abiVersion(napi_env env, napi_callback_info)
+{
+  napi_value result;
+  NAPI_CHECK(napi_create_int32(env, tca_abi_version(), &result));
+  return result;
+}
+
+static napi_value init(napi_env env, napi_value exports)
+{
+  napi_property_descriptor props[] = {
+      {"create", nullptr, create, nullptr, nullptr, nullptr, napi_default, nullptr},
+      {"solve", nullptr, solve, nullptr, nullptr, nullptr, napi_default, nullptr},
+      {"free", nullptr, freeEngine, nullptr, nullptr, nullptr, napi_default, nullptr},
+      {"problems", nullptr, problems, nullptr, nullptr, nullptr, napi_default, nullptr},
+      {"abiVersion", nullptr, abiVersion, nullptr, nullptr, nullptr, napi_default, nullptr},
+  };
+  NAPI_CHECK(napi_define_properties(env, exports, sizeof(props) / sizeof(props[0]), props));
+  return exports;
+}
+
+NAPI_MODULE(tca_engines, init)
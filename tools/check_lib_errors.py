@@ -0,0 +1,62 @@
+#!/usr/bin/env python3
+"""
+CTest helper: an engine failure must come back through the C ABI as an
+error the caller can catch, and must not end the calling process.
+
+Usage: check_lib_errors.py <libtca_engines.so>
+Caps this process's address space (RLIMIT_AS) at what it already uses
+plus CAP_MB, then asks the 1530 SAM for a line that needs far more node
+memory than that. The arenas throw std::bad_alloc, tca_engine_solve()
+returns -1 and the ctypes wrapper raises RuntimeError. The same engine
+must then still answer a small input.
+"""
+
+import os
+import random
+import resource
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.dirname(os.path.abspath(__file__))),
+                                'BeeCrowd', 'lib'))
+from tca_engines import Engine, load  # noqa: E402
+
+CAP_MB = 256
+LINE = 4000000  # Random letters: ~8M states, about 1 GB of rows
+
+
+def address_space():
+    """Bytes mapped by this process (VmSize)."""
+    with open('/proc/self/status') as f:
+        for line in f:
+            if line.startswith('VmSize:'):
+                return int(line.split()[1]) * 1024
+    raise RuntimeError('no VmSize in /proc/self/status')
+
+
+def main():
+    load(sys.argv[1])
+    rng = random.Random(1530)
+    line = bytes(rng.choices(b'abcdefghijklmnopqrstuvwxyz', k=LINE)) + b'?\n'
+
+    cap = address_space() + (CAP_MB << 20)
+    resource.setrlimit(resource.RLIMIT_AS, (cap, resource.getrlimit(resource.RLIMIT_AS)[1]))
+
+    # Built under the cap: its arenas size their reservations from it
+    with Engine('1530') as engine:
+        try:
+            engine.solve(line)
+        except RuntimeError as e:
+            print('error as expected: %s' % e)
+        else:
+            print('a %d-character line fit in %d MB: raise LINE' % (LINE, CAP_MB))
+            return 1
+
+        got = engine.solve('abc?\n')
+        if got != '6\n':
+            print('after the error: got %r, expected %r' % (got, '6\n'))
+            return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
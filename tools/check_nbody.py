@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+"""
+CTest helper: the 1324 N-body search must print, for every block, the
+earliest collision over all pairs of the block.
+
+Usage: check_nbody.py <p1324_nbody> <p1324> [blocks]
+Generates random small blocks, runs them through <p1324_nbody>, and
+feeds every pair of every block to the pair solver <p1324>. The
+minimum pair answer of a block must equal the N-body answer. The
+coefficients are small, and particles are copied with a shared line,
+speed or start, so each candidate source of solution_nbody.cpp is hit.
+"""
+
+import random
+import subprocess
+import sys
+from fractions import Fraction
+
+SEED = 1324
+BLOCKS = 2000
+
+
+def particle(rng, block):
+    if block and rng.random() < 0.3:
+        a, b, c, d = rng.choice(block)
+        kind = rng.randrange(4)
+        if kind == 0:
+            # Same radial line, the other way round half of the time
+            if rng.random() < 0.5:
+                a, b, d = -a, -b, d + 180
+            c, d = rng.randint(-4, 4), rng.randint(0, 7) * 45
+        elif kind == 1:
+            # Same speed, the angle equal mod 180 half of the time
+            a, b = rng.randint(-4, 4), rng.randint(-6, 6)
+            d = (d + 180 * rng.randint(0, 1)) if rng.random() < 0.5 else rng.randint(0, 7) * 45
+        elif kind == 2:
+            # Same point at t = 0
+            a, c = rng.randint(-4, 4), rng.randint(-4, 4)
+        elif kind == 3:
+            # Same origin crossing: a scaled copy of the radius
+            k = rng.choice((-2, -1, 2, 3))
+            a, b, c, d = a * k, b * k, rng.randint(-4, 4), rng.randint(0, 359)
+        return a, b, c, d % 360
+    return (rng.randint(-4, 4), rng.randint(-20, 20), rng.randint(-4, 4),
+            rng.choice((rng.randint(0, 7) * 45, rng.randint(0, 359))))
+
+
+def run(binary, text):
+    proc = subprocess.run([binary], input=text.encode(), stdout=subprocess.PIPE)
+    if proc.returncode != 0:
+        raise SystemExit('%s exited with %d' % (binary, proc.returncode))
+    return proc.stdout.decode().split('\n')[:-1]
+
+
+def main():
+    nbody, pairs = sys.argv[1:3]
+    blocks = int(sys.argv[3]) if len(sys.argv) > 3 else BLOCKS
+    rng = random.Random(SEED)
+
+    systems = []
+    for _ in range(blocks):
+        block = []
+        for _ in range(rng.randint(2, 12)):
+            block.append(particle(rng, block))
+        systems.append(block)
+
+    text = ''.join('%d\n' % len(block) + ''.join('%d %d %d %d\n' % p for p in block)
+                   for block in systems) + '0\n'
+    got = run(nbody, text)
+
+    pair_lines = []
+    for block in systems:
+        for i in range(len(block)):
+            for j in range(i + 1, len(block)):
+                pair_lines.append('%d %d %d %d %d %d %d %d\n' % (block[i] + block[j]))
+    answers = iter(run(pairs, ''.join(pair_lines) + '0 0 0 0 0 0 0 0\n'))
+
+    if len(got) != len(systems):
+        print('%d answers for %d blocks' % (len(got), len(systems)))
+        return 1
+    for k, block in enumerate(systems):
+        best = None
+        for _ in range(len(block) * (len(block) - 1) // 2):
+            num, den = map(int, next(answers).split())
+            if den != 0 and (best is None or Fraction(num, den) < best[0]):
+                best = (Fraction(num, den), '%d %d' % (num, den))
+        expected = best[1] if best else '0 0'
+        if got[k] != expected:
+            print('block %d: got %s, all pairs give %s' % (k, got[k], expected))
+            print('%d\n' % len(block) + ''.join('%d %d %d %d\n' % p for p in block), end='')
+            return 1
+    print('%d blocks match' % len(systems))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
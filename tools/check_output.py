@@ -0,0 +1,49 @@
+#!/usr/bin/env python3
+"""
+CTest helper: runs a solution on an input file and compares its output
+with the expected file.
+
+Usage: check_output.py <binary> <input> <expected> [args...]
+The arguments after <expected> are passed to <binary> (e.g. an
+interpreter and its script).
+The expected files were saved by hand on different systems, so the
+comparison ignores the encoding (UTF-8 or UTF-16 with BOM), CRLF line
+ends and a missing final newline.
+"""
+
+import subprocess
+import sys
+
+
+def decode(data):
+    if data.startswith(b'\xff\xfe') or data.startswith(b'\xfe\xff'):
+        text = data.decode('utf-16')
+    else:
+        text = data.decode('utf-8-sig')
+    return [line.rstrip() for line in text.replace('\r\n', '\n').rstrip('\n').split('\n')]
+
+
+def main():
+    binary, input_path, expected_path = sys.argv[1:4]
+    with open(input_path, 'rb') as fin:
+        proc = subprocess.run([binary] + sys.argv[4:], stdin=fin, stdout=subprocess.PIPE)
+    if proc.returncode != 0:
+        print('%s exited with %d' % (binary, proc.returncode))
+        return 1
+
+    got = decode(proc.stdout)
+    with open(expected_path, 'rb') as f:
+        want = decode(f.read())
+
+    for i, (g, w) in enumerate(zip(got, want)):
+        if g != w:
+            print('line %d: got %r, expected %r' % (i + 1, g, w))
+            return 1
+    if len(got) != len(want):
+        print('got %d lines, expected %d' % (len(got), len(want)))
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
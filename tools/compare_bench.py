@@ -0,0 +1,59 @@
+#!/usr/bin/env python3
+"""
+Compares two run_bench.py --json reports, e.g. from two commits.
+
+Usage: compare_bench.py <before.json> <after.json> [--threshold PCT]
+Prints one line per (engine, input) found in both reports: the best
+times and the speedup (before / after). Changes within the threshold
+(default 5%) are left unmarked, since single runs are noisy. Outputs
+whose digest changed between the reports are flagged as well.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        report = json.load(f)
+    return report, {(r['engine'], r['input']): r for r in report['results']}
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    ap.add_argument('before')
+    ap.add_argument('after')
+    ap.add_argument('--threshold', type=float, default=5.0, help='percent')
+    args = ap.parse_args()
+
+    old_report, old = load(args.before)
+    new_report, new = load(args.after)
+    print('before: %s  after: %s' % (old_report.get('commit'), new_report.get('commit')))
+    print('%-16s %-20s %10s %10s %8s' % ('engine', 'input', 'before s', 'after s', 'speedup'))
+
+    changed_output = False
+    for key in sorted(old.keys() & new.keys()):
+        a, b = old[key], new[key]
+        if 'best_s' not in a or 'best_s' not in b:
+            print('%-16s %-20s %10s %10s' % (key + (
+                a.get('best_s', a['status']), b.get('best_s', b['status']))))
+            continue
+        ratio = a['best_s'] / b['best_s']
+        mark = ''
+        if abs(ratio - 1) * 100 > args.threshold:
+            mark = '  faster' if ratio > 1 else '  SLOWER'
+        if a.get('output_sha1') != b.get('output_sha1'):
+            mark += '  OUTPUT CHANGED'
+            changed_output = True
+        print('%-16s %-20s %10.3f %10.3f %7.2fx%s' % (key + (a['best_s'], b['best_s'], ratio, mark)))
+
+    for key in sorted(old.keys() - new.keys()):
+        print('%-16s %-20s only in %s' % (key + (args.before,)))
+    for key in sorted(new.keys() - old.keys()):
+        print('%-16s %-20s only in %s' % (key + (args.after,)))
+    return 1 if changed_output else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
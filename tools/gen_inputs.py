@@ -0,0 +1,350 @@
+#!/usr/bin/env python3
+"""
+Generates the large inputs used to train PGO builds and to benchmark the
+C++ solutions (see CMakeLists.txt: targets `inputs`, `bench`, `pgo-train`).
+
+Usage: gen_inputs.py --out DIR [--seed S] [--scale F] [--list] [name ...]
+Writes DIR/<format>-<class>.in for every input class (or only the listed
+formats / classes). <format> is the input format an engine reads (the
+second column of engines.tsv), <class> the shape of the data.
+Inputs are deterministic: every class has its own generator, seeded with
+"<format>-<class>-<seed>". --scale multiplies the number of test cases
+(never the size of one case), so --scale 0.1 gives quick smoke inputs.
+"""
+
+import argparse
+import os
+import random
+
+CELLS = [c + r for c in 'ABCDE' for r in '12345']
+
+
+def cases(n, scale):
+    return max(1, int(n * scale))
+
+
+# ---------------------------------------------------------------
+# 1023 - Drought
+# ---------------------------------------------------------------
+def gen_1023_cities(rng, scale):
+    # Cities of 1000 houses, consumption a multiple of the residents
+    for _ in range(cases(600, scale)):
+        yield '1000\n'
+        for _ in range(1000):
+            x = rng.randint(1, 10)
+            yield '%d %d\n' % (x, x * rng.randint(0, 200))
+    yield '0\n'
+
+
+def gen_1023_one_city(rng, scale):
+    # Cities of 10^6 houses (the limit): one sort of 10^6 keys each
+    for _ in range(cases(2, scale)):
+        yield '1000000\n'
+        for _ in range(1000000):
+            x = rng.randint(1, 10)
+            yield '%d %d\n' % (x, x * rng.randint(0, 200))
+    yield '0\n'
+
+
+# ---------------------------------------------------------------
+# 1034 - Ice Statues Festival
+# ---------------------------------------------------------------
+def gen_1034_small(rng, scale):
+    # Many small coin sets, M up to 10^6 (the greedy part does the rest)
+    t = cases(100000, scale)
+    yield '%d\n' % t
+    for _ in range(t):
+        n = rng.randint(2, 5)
+        coins = [1] + [rng.randint(2, 12) for _ in range(n - 1)]
+        yield '%d %d\n%s\n' % (n, rng.randint(1, 10**6), ' '.join(map(str, coins)))
+
+
+def gen_1034_large_m(rng, scale):
+    # Up to 25 blocks of 1-100 cm and M close to 10^6: the DP runs on
+    # the full ~10^4 remainder every time
+    t = cases(3000, scale)
+    yield '%d\n' % t
+    for _ in range(t):
+        n = rng.randint(15, 25)
+        coins = [1] + rng.sample(range(2, 101), n - 1)
+        rng.shuffle(coins)
+        yield '%d %d\n%s\n' % (n, rng.randint(9 * 10**5, 10**6), ' '.join(map(str, coins)))
+
+
+# ---------------------------------------------------------------
+# 1053 - Continuous Drawing
+# ---------------------------------------------------------------
+def gen_1053_strokes(rng, scale):
+    # Drawings of 1-4 strokes on the 5x5 grid
+    t = cases(100000, scale)
+    yield '%d\n' % t
+    for _ in range(t):
+        n = rng.randint(1, 4)
+        yield '%d\n' % n
+        for _ in range(n):
+            a, b = rng.sample(CELLS, 2)
+            yield '%s %s\n' % (a, b)
+
+
+def gen_1053_dense(rng, scale):
+    # Connected drawings of 15-40 strokes. A stroke only flips the degree
+    # parity of its two end points, so the odd nodes are known here: the
+    # matching search is (k-1)!! for k odd nodes, keep k <= 12.
+    t = cases(5000, scale)
+    yield '%d\n' % t
+    for _ in range(t):
+        while True:
+            n = rng.randint(15, 40)
+            strokes, touched, odd = [], [rng.choice(CELLS)], set()
+            for _ in range(n):
+                a = rng.choice(touched)
+                b = rng.choice([c for c in CELLS if c != a])
+                strokes.append((a, b))
+                touched.append(b)
+                odd ^= {a, b}
+            if len(odd) <= 12:
+                break
+        yield '%d\n' % n
+        for a, b in strokes:
+            yield '%s %s\n' % (a, b)
+
+
+# ---------------------------------------------------------------
+# 1058 - Independent Attacking Zones
+# ---------------------------------------------------------------
+def gen_1058_small(rng, scale):
+    # Circles of 3-12 red/black points
+    t = cases(100000, scale)
+    yield '%d\n' % t
+    for _ in range(t):
+        n = rng.randint(3, 12)
+        yield '%d\n%s\n' % (n, ''.join(rng.choice('RB') for _ in range(n)))
+
+
+def gen_1058_large(rng, scale):
+    # Circles of 30-39 points (P < 40), mostly black: few memo hits
+    t = cases(20000, scale)
+    yield '%d\n' % t
+    for _ in range(t):
+        n = rng.randint(30, 39)
+        yield '%d\n%s\n' % (n, ''.join(rng.choice('RBBBB') for _ in range(n)))
+
+
+# ---------------------------------------------------------------
+# 1141 - Growing Strings
+# ---------------------------------------------------------------
+def gen_1141_wide(rng, scale):
+    # Dictionaries of 60k short words, ~10^6 characters each
+    for _ in range(cases(4, scale)):
+        words = set()
+        while len(words) < 60000:
+            words.add(''.join(rng.choice('abcdefghij') for _ in range(rng.randint(3, 30))))
+        words = sorted(words)  # Set order depends on the string hash seed
+        rng.shuffle(words)
+        yield '%d\n' % len(words)
+        for w in words:
+            yield w + '\n'
+    yield '0\n'
+
+
+def gen_1141_chains(rng, scale):
+    # The limits: 10^4 words of up to 1000 characters, 10^6 in total.
+    # Words grow from shorter ones by adding characters at either end,
+    # so the substring chains are long.
+    for _ in range(cases(4, scale)):
+        words, total = set(), 0
+        pool = [rng.choice('abcd')]
+        while len(words) < 10000 and total < 10**6 - 1000:
+            base = rng.choice(pool)
+            grow = ''.join(rng.choice('abcd') for _ in range(rng.randint(1, 40)))
+            w = (grow + base if rng.random() < 0.5 else base + grow)[:1000]
+            if w not in words:
+                words.add(w)
+                pool.append(w)
+                total += len(w)
+        words = sorted(words)
+        rng.shuffle(words)
+        yield '%d\n' % len(words)
+        for w in words:
+            yield w + '\n'
+    yield '0\n'
+
+
+# ---------------------------------------------------------------
+# 1231 - Words
+# ---------------------------------------------------------------
+def binary_word(rng, lo, hi):
+    return ''.join(rng.choice('01') for _ in range(rng.randint(lo, hi)))
+
+
+def gen_1231_small(rng, scale):
+    # Pairs of small binary-code dictionaries
+    for _ in range(cases(60000, scale)):
+        n1, n2 = rng.randint(1, 5), rng.randint(1, 5)
+        yield '%d %d\n' % (n1, n2)
+        for _ in range(n1 + n2):
+            yield binary_word(rng, 1, 8) + '\n'
+
+
+def gen_1231_max(rng, scale):
+    # The limits: 20 + 20 codes of up to 40 bits. Both sets are built from
+    # the same few short blocks, so the codes keep matching each other and
+    # the search visits many (node A, node B) states.
+    for _ in range(cases(3000, scale)):
+        blocks = [binary_word(rng, 1, 5) for _ in range(4)]
+        yield '20 20\n'
+        for _ in range(40):
+            w = ''
+            for _ in range(rng.randint(1, 10)):
+                w += rng.choice(blocks)
+            yield w[:40] + '\n'
+
+
+def gen_1231_kdict_small(rng, scale):
+    # solution_kdict.cpp format: k n1 .. nk, then the words
+    for _ in range(cases(60000, scale)):
+        k = rng.randint(2, 3)
+        ns = [rng.randint(1, 4) for _ in range(k)]
+        yield '%d %s\n' % (k, ' '.join(map(str, ns)))
+        for _ in range(sum(ns)):
+            yield binary_word(rng, 1, 8) + '\n'
+
+
+# ---------------------------------------------------------------
+# 1324 - Higgs Boson
+# ---------------------------------------------------------------
+def gen_1324_pairs(rng, scale):
+    # Particle pairs: a1 b1 c1 d1 a2 b2 c2 d2
+    for _ in range(cases(500000, scale)):
+        yield ' '.join(str(rng.randint(-100, 100)) for _ in range(8)) + '\n'
+    yield '0 0 0 0 0 0 0 0\n'
+
+
+def gen_1324_large(rng, scale):
+    # Coefficients up to ~10^11, where the cross-multiplied products of
+    # the batch kernels overflow 64 bits. Starts with a known regression.
+    yield '-149999999999 150000000000 10000000000 0 -149999999999 150000000000 0 100\n'
+    big = 150000000000
+    for i in range(cases(200000, scale)):
+        a1, b1 = rng.randint(-big, big), rng.randint(-big, big)
+        c1, c2 = rng.randint(-10**10, 10**10), rng.randint(-10**10, 10**10)
+        d1, d2 = rng.randint(0, 359), rng.randint(0, 359)
+        kind = i % 3
+        if kind == 0:
+            # Identical lines: zero crossing against angle alignment
+            a2, b2 = a1, b1
+        elif kind == 1:
+            # Crossing lines, nearly parallel: large fractions
+            a2, b2 = a1 + rng.choice((-1, 1)), rng.randint(-big, big)
+        else:
+            a2, b2 = rng.randint(-big, big), rng.randint(-big, big)
+        yield '%d %d %d %d %d %d %d %d\n' % (a1, b1, c1, d1, a2, b2, c2, d2)
+    yield '0 0 0 0 0 0 0 0\n'
+
+
+def gen_1324_nbody_systems(rng, scale):
+    # solution_nbody.cpp format: n, then n particles a b c d
+    for _ in range(cases(20000, scale)):
+        n = rng.randint(2, 30)
+        yield '%d\n' % n
+        for _ in range(n):
+            yield '%d %d %d %d\n' % (rng.randint(-50, 50), rng.randint(1, 100),
+                                     rng.randint(-20, 20), rng.randint(0, 359))
+    yield '0\n'
+
+
+# ---------------------------------------------------------------
+# 1346 - Child Play
+# ---------------------------------------------------------------
+def gen_1346_small(rng, scale):
+    # Card sets of 1-10 cards
+    for _ in range(cases(50000, scale)):
+        n = rng.randint(1, 10)
+        yield '%d\n' % n
+        for _ in range(n):
+            yield '%d %d\n' % (rng.randint(0, 600), rng.randint(0, 600))
+    yield '0\n'
+
+
+def gen_1346_large(rng, scale):
+    # Card sets of 50-400 cards with faces up to 1000
+    for _ in range(cases(200, scale)):
+        n = rng.randint(50, 400)
+        yield '%d\n' % n
+        for _ in range(n):
+            yield '%d %d\n' % (rng.randint(0, 1000), rng.randint(0, 1000))
+    yield '0\n'
+
+
+# ---------------------------------------------------------------
+# 1530 - How Many Substrings
+# ---------------------------------------------------------------
+def gen_1530_short(rng, scale):
+    # Short lines with '?' queries
+    for _ in range(cases(500000, scale)):
+        yield ''.join(rng.choice('abc??') for _ in range(rng.randint(1, 30))) + '\n'
+
+
+def gen_1530_long(rng, scale):
+    # Lines of 200,000 characters (the limit) with a '?' every ~100
+    for _ in range(cases(20, scale)):
+        line = [rng.choice('abcdefghijklmnopqrstuvwxyz') for _ in range(200000)]
+        for i in rng.sample(range(200000), 2000):
+            line[i] = '?'
+        yield ''.join(line) + '\n'
+
+
+# name -> generator; the name is <format>-<class>
+GENERATORS = {
+    '1023-cities': gen_1023_cities,
+    '1023-one_city': gen_1023_one_city,
+    '1034-small': gen_1034_small,
+    '1034-large_m': gen_1034_large_m,
+    '1053-strokes': gen_1053_strokes,
+    '1053-dense': gen_1053_dense,
+    '1058-small': gen_1058_small,
+    '1058-large': gen_1058_large,
+    '1141-wide': gen_1141_wide,
+    '1141-chains': gen_1141_chains,
+    '1231-small': gen_1231_small,
+    '1231-max': gen_1231_max,
+    '1231_kdict-small': gen_1231_kdict_small,
+    '1324-pairs': gen_1324_pairs,
+    '1324-large': gen_1324_large,
+    '1324_nbody-systems': gen_1324_nbody_systems,
+    '1346-small': gen_1346_small,
+    '1346-large': gen_1346_large,
+    '1530-short': gen_1530_short,
+    '1530-long': gen_1530_long,
+}
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    ap.add_argument('--out', help='output directory')
+    ap.add_argument('--seed', type=int, default=0)
+    ap.add_argument('--scale', type=float, default=1.0, help='test-case count multiplier')
+    ap.add_argument('--list', action='store_true', help='list the input classes and exit')
+    ap.add_argument('names', nargs='*', help='formats (1346) or classes (1346-large); default: all')
+    args = ap.parse_args()
+
+    if args.list:
+        print('\n'.join(sorted(GENERATORS)))
+        return
+    if not args.out:
+        ap.error('--out is required')
+
+    selected = sorted(g for g in GENERATORS
+                      if not args.names or g in args.names or g.split('-')[0] in args.names)
+    if not selected:
+        ap.error('no input class matches %s' % ' '.join(args.names))
+
+    os.makedirs(args.out, exist_ok=True)
+    for name in selected:
+        rng = random.Random('%s-%d' % (name, args.seed))
+        with open(os.path.join(args.out, name + '.in'), 'w') as f:
+            f.writelines(GENERATORS[name](rng, args.scale))
+
+
+if __name__ == '__main__':
+    main()
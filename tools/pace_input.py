@@ -0,0 +1,46 @@
+#!/usr/bin/env python3
+"""
+Writes an input file to stdout at a fixed rate, like a slow producer at
+the other end of a pipe (a network stream, a decompressor on another
+core). Each chunk takes chunk / rate seconds to "produce", and nothing
+is produced while the write blocks on a full pipe.
+
+Usage: pace_input.py <input> <MB/s> [--chunk KB] | <solution>
+
+Used to time BlockReader::ASYNC against the fread path
+(common/README.md):
+    tools/pace_input.py big.in 200 --chunk 1000 | TCA_READER=sync build/bin/p1023
+    tools/pace_input.py big.in 200 --chunk 1000 | TCA_READER=async build/bin/p1023
+"""
+
+import argparse
+import os
+import sys
+import time
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    ap.add_argument('input')
+    ap.add_argument('rate', type=float, help='MB/s')
+    ap.add_argument('--chunk', type=int, default=1000, help='KB per write (default 1000)')
+    args = ap.parse_args()
+
+    with open(args.input, 'rb') as f:
+        data = memoryview(f.read())
+    chunk = args.chunk << 10
+    delay = chunk / (args.rate * 1e6)
+    out = sys.stdout.fileno()
+    try:
+        for off in range(0, len(data), chunk):
+            time.sleep(delay)
+            part = data[off:off + chunk]
+            while part:
+                part = part[os.write(out, part):]
+    except BrokenPipeError:
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,21 @@
+#!/bin/sh
+# Two-stage profile-guided build of every solution.
+#
+# Usage: tools/pgo.sh [build-dir]   (default: _build/pgo)
+#   1. configure with TCA_PGO=GENERATE, build the instrumented binaries
+#   2. pgo-train: run each one on its generated input, writing profiles
+#   3. reconfigure the SAME directory with TCA_PGO=USE and rebuild
+# Extra cmake arguments can be passed in CMAKE_ARGS (e.g. -DTCA_LTO=ON).
+set -e
+
+SRC=$(cd "$(dirname "$0")/.." && pwd)
+BUILD=${1:-"$SRC/_build/pgo"}
+JOBS=$(nproc 2>/dev/null || echo 4)
+
+cmake -S "$SRC" -B "$BUILD" -DCMAKE_BUILD_TYPE=Release -DTCA_PGO=GENERATE $CMAKE_ARGS
+cmake --build "$BUILD" -j"$JOBS"
+cmake --build "$BUILD" --target pgo-train
+
+cmake -S "$SRC" -B "$BUILD" -DTCA_PGO=USE $CMAKE_ARGS
+cmake --build "$BUILD" -j"$JOBS"
+echo "PGO binaries: $BUILD/bin"
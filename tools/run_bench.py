@@ -0,0 +1,249 @@
+#!/usr/bin/env python3
+"""
+Runs every C++ engine on the generated inputs of its format and prints a
+timing table, optionally saved as JSON.
+
+Usage: run_bench.py --engines build/engines.tsv --inputs build/inputs
+                    [--runs N] [--timeout S] [--ports] [--only NAME ...]
+                    [--perf] [--json out.json] [--quiet]
+engines.tsv is written by CMake: one "<engine>\t<format>\t<binary>" line
+per target. Each engine reads every <inputs>/<format>-<class>.in (see
+gen_inputs.py). The best and the median of N runs are kept.
+--ports also times the JavaScript / Python ports of the repository
+(node / python3 from PATH; a missing interpreter skips its ports).
+Outputs are compared token by token (the ports break lines and end them
+differently). Every C++ engine that runs on an input must print the same
+output, otherwise the run fails. A port that disagrees with them or
+crashes is only reported: several ports are older than the C++ engines.
+A run over --timeout seconds is reported as "timeout", not as a failure.
+--perf adds one untimed run per (engine, input) with TCA_PERF_OUT set:
+engines built on common/fastio.hpp then report hardware counters
+(common/perf.hpp) for their solve and I/O phases. Counters the kernel
+refuses are listed once and left out; the ports report none.
+The `pgo-train` target is this script with --runs 1 --quiet.
+
+The JSON file holds the commit, the machine and one record per
+(engine, input); tools/compare_bench.py compares two of them.
+"""
+
+import argparse
+import glob
+import hashlib
+import json
+import os
+import tempfile
+import platform
+import shutil
+import statistics
+import subprocess
+import sys
+import time
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+# Ports that read stdin: (engine, format, interpreter, source)
+# 1324 solution.js reads a fixed local file and 1346 solution.js is empty,
+# so they are not listed.
+PORTS = [
+    ('1023.js', '1023', 'node', 'BeeCrowd/1023-Drought/solution.js'),
+    ('1034.js', '1034', 'node', 'BeeCrowd/1034-Ice-Statues-Festival/solution.js'),
+    ('1053.js', '1053', 'node', 'BeeCrowd/1053-Continuous-Drawing/solution.js'),
+    ('1053.py', '1053', 'python3', 'BeeCrowd/1053-Continuous-Drawing/solution.py'),
+    ('1058.js', '1058', 'node', 'BeeCrowd/1058-Independent-Attacking-Zones/solution.js'),
+    ('1058.py', '1058', 'python3', 'BeeCrowd/1058-Independent-Attacking-Zones/solution.py'),
+    ('1141.js', '1141', 'node', 'BeeCrowd/1141-Growing-Strings/solution.js'),
+    ('1231.js', '1231', 'node', 'BeeCrowd/1231-Words/solution.js'),
+    ('1346.py', '1346', 'python3', 'BeeCrowd/1346-Child-Play/solution.py'),
+    ('1530_ukkonen.js', '1530', 'node', 'BeeCrowd/1530-How-Many-Substrings/solution_Ukkonen.js'),
+]
+
+
+def read_engines(path):
+    engines = []
+    with open(path) as f:
+        for line in f:
+            line = line.rstrip('\n')
+            if line:
+                name, fmt, binary = line.split('\t')
+                engines.append((name, 'cpp', fmt, [binary]))
+    return engines
+
+
+def read_ports():
+    ports = []
+    for name, fmt, interpreter, source in PORTS:
+        exe = shutil.which(interpreter)
+        if exe is None:
+            print('skipping %s: %s not found' % (name, interpreter))
+            continue
+        ports.append((name, interpreter, fmt, [exe, os.path.join(ROOT, source)]))
+    return ports
+
+
+def digest(output):
+    return hashlib.sha1(b' '.join(output.split())).hexdigest()
+
+
+def run_once(cmd, input_path, timeout):
+    """Returns (status, seconds, output digest); status is ok, timeout or error."""
+    with open(input_path, 'rb') as fin:
+        t0 = time.perf_counter()
+        try:
+            proc = subprocess.run(cmd, stdin=fin, stdout=subprocess.PIPE,
+                                  stderr=subprocess.DEVNULL, timeout=timeout)
+        except subprocess.TimeoutExpired:
+            return 'timeout', None, None
+        secs = time.perf_counter() - t0
+    if proc.returncode != 0:
+        return 'error', None, None
+    return 'ok', secs, digest(proc.stdout)
+
+
+def run_perf(cmd, input_path, timeout):
+    """One run with TCA_PERF_OUT set; returns the parsed report or None."""
+    fd, path = tempfile.mkstemp(suffix='.json', prefix='perf-')
+    os.close(fd)
+    os.unlink(path)  # The engine creates it only if it has counters
+    env = dict(os.environ, TCA_PERF_OUT=path)
+    try:
+        with open(input_path, 'rb') as fin:
+            subprocess.run(cmd, stdin=fin, stdout=subprocess.DEVNULL,
+                           stderr=subprocess.DEVNULL, timeout=timeout, env=env)
+        with open(path) as f:
+            return json.load(f)
+    except (subprocess.TimeoutExpired, OSError, ValueError):
+        return None
+    finally:
+        if os.path.exists(path):
+            os.unlink(path)
+
+
+def per_kilo(phase, event, base='instructions'):
+    if event in phase and phase.get(base):
+        return 1000.0 * phase[event] / phase[base]
+    return None
+
+
+def perf_line(perf):
+    """Compact summary of a perf report for the table."""
+    solve, io = perf['solve'], perf['io']
+    parts = []
+    if solve.get('cycles'):
+        parts.append('IPC %.2f' % (solve.get('instructions', 0) / solve['cycles']))
+    for event, label in (('l1d_read_misses', 'L1d'), ('llc_read_misses', 'LLC'),
+                         ('dtlb_read_misses', 'dTLB'), ('branch_misses', 'br')):
+        v = per_kilo(solve, event)
+        if v is not None:
+            parts.append('%s %.2f/ki' % (label, v))
+    if 'task_clock_ns' in solve:
+        total = solve['task_clock_ns'] + io['task_clock_ns']
+        parts.append('cpu %.3f s, io %.1f%%' % (
+            total / 1e9, 100.0 * io['task_clock_ns'] / total if total else 0))
+    if 'page_faults' in solve:
+        parts.append('faults %d + %d io' % (solve['page_faults'], io['page_faults']))
+    return ', '.join(parts)
+
+
+def git_commit():
+    try:
+        rev = subprocess.run(['git', '-C', ROOT, 'rev-parse', '--short', 'HEAD'],
+                             stdout=subprocess.PIPE, stderr=subprocess.DEVNULL,
+                             universal_newlines=True, check=True).stdout.strip()
+        dirty = subprocess.run(['git', '-C', ROOT, 'status', '--porcelain', '--untracked-files=no'],
+                               stdout=subprocess.PIPE, universal_newlines=True).stdout.strip()
+        return rev + ('-dirty' if dirty else '')
+    except (OSError, subprocess.CalledProcessError):
+        return None
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    ap.add_argument('--engines', required=True)
+    ap.add_argument('--inputs', required=True)
+    ap.add_argument('--runs', type=int, default=3)
+    ap.add_argument('--timeout', type=float, default=60.0, help='seconds per run')
+    ap.add_argument('--ports', action='store_true', help='also time the .js / .py ports')
+    ap.add_argument('--only', nargs='+', metavar='NAME', help='engines, formats or inputs to run')
+    ap.add_argument('--perf', action='store_true', help='hardware counters (one extra run)')
+    ap.add_argument('--json', metavar='FILE', help='write the results as JSON')
+    ap.add_argument('--quiet', action='store_true', help='no table (PGO training)')
+    args = ap.parse_args()
+
+    engines = read_engines(args.engines)
+    if args.ports:
+        engines += read_ports()
+
+    perf_refused = {}  # event -> reason, reported once
+    reference = {}  # input -> (engine, output digest)
+    results = []
+    failed = False
+    if not args.quiet:
+        print('%-16s %-20s %10s %10s %10s' % ('engine', 'input', 'best s', 'median s', 'MB/s'))
+    for name, kind, fmt, cmd in engines:
+        for input_path in sorted(glob.glob(os.path.join(args.inputs, fmt + '-*.in'))):
+            key = os.path.basename(input_path)[:-3]
+            if args.only and not {name, fmt, key} & set(args.only):
+                continue
+
+            times = []
+            for _ in range(args.runs):
+                status, secs, out = run_once(cmd, input_path, args.timeout)
+                if status != 'ok':
+                    break
+                times.append(secs)
+
+            size = os.path.getsize(input_path)
+            record = {'engine': name, 'kind': kind, 'input': key, 'bytes': size, 'status': status}
+            if status == 'error' and kind == 'cpp':
+                print('ERROR: %s exited with an error on %s.in' % (name, key))
+                failed = True
+            if status == 'ok':
+                best = min(times)
+                record.update(best_s=round(best, 6),
+                              median_s=round(statistics.median(times), 6),
+                              mb_s=round(size / 1e6 / best, 3), output_sha1=out)
+                if key in reference and reference[key][1] != out:
+                    print('MISMATCH: %s and %s disagree on %s.in' % (reference[key][0], name, key))
+                    record['status'] = 'mismatch'
+                    failed = failed or kind == 'cpp'
+                if kind == 'cpp':
+                    reference.setdefault(key, (name, out))
+            perf = run_perf(cmd, input_path, args.timeout) if args.perf and status == 'ok' else None
+            if perf is not None:
+                record['perf'] = perf
+                perf_refused.update(perf.get('unavailable', {}))
+            results.append(record)
+
+            if not args.quiet:
+                if status != 'ok':
+                    print('%-16s %-20s %10s' % (name, key, status))
+                else:
+                    print('%-16s %-20s %10.3f %10.3f %10.1f' % (
+                        name, key, record['best_s'], record['median_s'], record['mb_s']))
+                if perf is not None and perf_line(perf):
+                    print('%16s   solve: %s' % ('', perf_line(perf)))
+                sys.stdout.flush()
+
+    if perf_refused and not args.quiet:
+        print('perf counters not available: %s' % ', '.join(
+            '%s (%s)' % item for item in sorted(perf_refused.items())))
+        if {'Permission denied', 'Operation not permitted'} & set(perf_refused.values()):
+            print('  (see /proc/sys/kernel/perf_event_paranoid)')
+
+    if args.json:
+        report = {
+            'commit': git_commit(),
+            'date': time.strftime('%Y-%m-%dT%H:%M:%S%z'),
+            'host': platform.node(),
+            'machine': platform.machine(),
+            'runs': args.runs,
+            'results': results,
+        }
+        with open(args.json, 'w') as f:
+            json.dump(report, f, indent=1)
+            f.write('\n')
+    return 1 if failed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())